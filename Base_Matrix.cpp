@@ -1,38 +1,373 @@
 #include "Base_Matrix.h"
+#include "Instrumentation.h"
+#include "Matrix_Writer.h"
+#include "Numa.h"
+#include "Parallel.h"
+#include "Reduction.h"
+#include "Strassen.h"
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+struct Binary_Header{ // on disk header of the binary format, exactly 64 bytes
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t dtype; // 1 = 64 bit IEEE 754 double
+    uint32_t layout; // 0 = row major
+    uint64_t rows;
+    uint64_t columns;
+    uint64_t alignment; // payload alignment in bytes
+    uint64_t payload_offset; // byte offset of the first value
+    uint32_t endianness; // written as 0x01020304 in the native byte order
+    uint32_t reserved;
+};
+static_assert(sizeof(Binary_Header) == 64, "Binary_Header must stay 64 bytes long");
+
+static const char binary_magic[8]{'M', 'A', 'T', 'R', 'I', 'C', 'E', 'S'};
+static const uint32_t binary_version{1};
+static const uint32_t binary_dtype_double{1};
+static const uint32_t binary_layout_row_major{0};
+static const uint64_t binary_alignment{64};
+static const uint32_t binary_endianness{0x01020304};
+
+Base_Matrix::Multiplication_Policy Base_Matrix::multiplication_policy{Base_Matrix::Standard};
+size_t Base_Matrix::strassen_cutoff{256};
+bool Base_Matrix::copy_on_write{false};
+
+struct Row_Storage_Header{ // placed in front of every row storage returned by allocate_rows
+    std::atomic<size_t> owners{1}; // matrices sharing the storage
+};
+
+static const size_t row_storage_offset{(sizeof(Row_Storage_Header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t)};
+
+static Row_Storage_Header* storage_header(Base_Vector* rows_of_values){
+    return reinterpret_cast<Row_Storage_Header*>(reinterpret_cast<char*>(rows_of_values) - row_storage_offset);
+}
+
+static const size_t reduction_chunk{1 << 15}; // values reduced by a single thread at least
+static const size_t reduction_block_rows{32}; // rows accumulated directly by the column reductions before the pairwise combination
+
+template<typename Result = data_type, typename Row_Reduction>
+static std::vector<Result> reduce_rows(const Base_Matrix &matrix, const Row_Reduction &reduce){ // reduce(values, count, parallel) of every row
+    size_t rows = matrix.get_rows();
+    size_t columns = matrix.get_columns();
+    std::vector<Result> results(rows);
+    if(rows == 1){ // a single long row is split inside the Reduction kernel instead
+        results[0] = reduce(matrix[0].data(), columns, true);
+        return results;
+    }
+    Parallel::for_range(0, rows, reduction_chunk / columns + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++)
+            results[r] = reduce(matrix[r].data(), columns, false);
+    });
+    return results;
+}
+
+template<typename Partial, typename Add, typename Combine>
+static std::vector<Partial> reduce_columns(const Base_Matrix &matrix, const Add &add, const Combine &combine){ // add(partial, value) down every column, the partials of the row blocks are merged by combine(partial, other)
+    size_t rows = matrix.get_rows();
+    size_t columns = matrix.get_columns();
+    size_t blocks = (rows + reduction_block_rows - 1) / reduction_block_rows;
+    std::vector<Partial> partials(blocks * columns); // one row of partials for every block of rows
+    Parallel::for_range(0, blocks, reduction_chunk / (reduction_block_rows * columns) + 1, [&](size_t first_block, size_t last_block){
+        for(size_t b{first_block} ; b < last_block ; b++){
+            Partial* out = &partials[b * columns];
+            size_t last_row = (b + 1 == blocks) ? rows : (b + 1) * reduction_block_rows;
+            for(size_t r{b * reduction_block_rows} ; r < last_row ; r++){
+                const data_type* row = matrix[r].data();
+                for(size_t c{} ; c < columns ; c++)
+                    add(out[c], row[c]);
+            }
+        }
+    });
+    for(size_t stride{1} ; stride < blocks ; stride *= 2) // the partial rows are combined pairwise, in an order independent of the thread count
+        for(size_t b{} ; b + stride < blocks ; b += 2 * stride){
+            Partial* out = &partials[b * columns];
+            const Partial* in = &partials[(b + stride) * columns];
+            for(size_t c{} ; c < columns ; c++)
+                combine(out[c], in[c]);
+        }
+    partials.resize(columns);
+    return partials;
+}
+
+template<typename Term>
+static std::vector<data_type> sum_columns(const Base_Matrix &matrix, const Term &term){ // sum of term(value) down every column
+    return reduce_columns<data_type>(matrix, [&term](data_type &sum, data_type value){ sum += term(value); }, [](data_type &sum, data_type other){ sum += other; });
+}
+
+struct Scaled_Squares{ // sum of squares kept as scale^2 * sum like LAPACK's dlassq, neither overflows nor underflows
+    data_type scale{0}; // largest absolute value seen, NaN once a NaN was seen
+    data_type sum{1}; // sum of (|value| / scale)^2
+
+    void add(data_type value){
+        data_type absolute = std::fabs(value);
+        if(absolute == 0 || std::isnan(scale) || std::isinf(scale))
+            return;
+        if(std::isnan(absolute) || std::isinf(absolute)){
+            scale = absolute;
+            sum = 1;
+        }
+        else if(absolute > scale){
+            sum = 1 + sum * (scale / absolute) * (scale / absolute);
+            scale = absolute;
+        }
+        else
+            sum += (absolute / scale) * (absolute / scale);
+    }
+
+    void combine(const Scaled_Squares &other){
+        if(other.scale == 0 || std::isnan(scale))
+            return;
+        if(std::isnan(other.scale) || std::isinf(other.scale) || (!std::isinf(scale) && other.scale > scale)){
+            if(std::isfinite(other.scale))
+                sum = other.sum + sum * (scale / other.scale) * (scale / other.scale);
+            else
+                sum = other.sum;
+            scale = other.scale;
+        }
+        else if(!std::isinf(scale))
+            sum += other.sum * (other.scale / scale) * (other.scale / scale);
+    }
+
+    data_type norm() const { return scale * std::sqrt(sum); }
+};
+
+template<typename Better>
+static std::vector<size_t> search_columns(const Base_Matrix &matrix, const Better &better){ // row index of the first best value of every column
+    size_t rows = matrix.get_rows();
+    size_t columns = matrix.get_columns();
+    std::vector<size_t> indices(columns, 0);
+    Parallel::for_range(0, columns, reduction_chunk / rows + 1, [&](size_t first_column, size_t last_column){
+        std::vector<data_type> best(matrix[0].data() + first_column, matrix[0].data() + last_column);
+        for(size_t r{1} ; r < rows ; r++){
+            const data_type* row = matrix[r].data();
+            for(size_t c{first_column} ; c < last_column ; c++)
+                if(better(row[c], best[c - first_column])){
+                    best[c - first_column] = row[c];
+                    indices[c] = r;
+                }
+        }
+    });
+    return indices;
+}
+
+static const size_t first_touch_chunk{1 << 18}; // values constructed by a single thread at least
+
+template<typename Construct>
+static void construct_rows(Base_Vector* rows_of_values, size_t rows, size_t columns, const Construct &construct){ // construct(slot, r) for every row, in parallel for big matrices so that the pages are first touched by the threads processing the rows later
+    size_t min_rows = first_touch_chunk / columns + 1;
+    bool interleaved = Numa::interleaves(rows * columns * sizeof(data_type)); // decided for the whole matrix, the rows may be far below the threshold
+    if(interleaved || rows < 2 * min_rows || Parallel::get_thread_count() == 1 || Parallel::is_serial_thread()){ // a single chunk, no bookkeeping to allocate
+        if(interleaved)
+            Numa::set_thread_interleaving(true); // the pages touched by this thread go round robin over the nodes
+        size_t r{};
+        try{
+            for( ; r < rows ; r++)
+                construct(&rows_of_values[r], r);
+        }
+        catch(...){
+            if(interleaved)
+                Numa::set_thread_interleaving(false);
+            Base_Matrix::release_rows(rows_of_values, r);
+            throw;
+        }
+        if(interleaved)
+            Numa::set_thread_interleaving(false);
+        return;
+    }
+    std::vector<unsigned char> constructed(rows, 0);
+    try{
+        Parallel::for_range(0, rows, min_rows, [&](size_t first_row, size_t last_row){
+            for(size_t r{first_row} ; r < last_row ; r++){
+                construct(&rows_of_values[r], r);
+                constructed[r] = 1;
+            }
+        });
+    }
+    catch(...){
+        for(size_t r{} ; r < rows ; r++)
+            if(constructed[r])
+                rows_of_values[r].~Base_Vector();
+        Base_Matrix::release_rows(rows_of_values, 0);
+        throw;
+    }
+}
+
+static const size_t element_wise_chunk{1 << 16}; // values processed by a single thread at least
+
+static bool broadcast_shape(const Base_Matrix &left, const Base_Matrix &right, size_t &columns, size_t &rows){ // shape of the broadcast result, false if the shapes are incompatible
+    auto combine = [](size_t left_size, size_t right_size, size_t &size){
+        if(left_size != right_size && left_size != 1 && right_size != 1)
+            return false;
+        size = (left_size == 1) ? right_size : left_size;
+        return true;
+    };
+    return combine(left.get_columns(), right.get_columns(), columns) && combine(left.get_rows(), right.get_rows(), rows);
+}
+
+template<typename Operation>
+static void broadcast(const Base_Matrix &left, const Base_Matrix &right, Base_Matrix &result, const Operation &operation){ // result = operation(left, right) element wise, a dimension of size 1 is repeated, result may be left
+    size_t columns = result.get_columns();
+    bool left_repeated = left.get_columns() == 1 && columns != 1; // a single value per row, repeated along the row
+    bool right_repeated = right.get_columns() == 1 && columns != 1;
+    Parallel::for_range(0, result.get_rows(), element_wise_chunk / columns + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++){
+            const data_type* left_row = left[(left.get_rows() == 1) ? 0 : r].data();
+            const data_type* right_row = right[(right.get_rows() == 1) ? 0 : r].data();
+            data_type* out = result[r].data();
+            if(!left_repeated && !right_repeated)
+                for(size_t c{} ; c < columns ; c++)
+                    out[c] = operation(left_row[c], right_row[c]);
+            else if(right_repeated){
+                data_type right_value{right_row[0]};
+                if(left_repeated)
+                    std::fill(out, out + columns, operation(left_row[0], right_value));
+                else
+                    for(size_t c{} ; c < columns ; c++)
+                        out[c] = operation(left_row[c], right_value);
+            }
+            else{
+                data_type left_value{left_row[0]};
+                for(size_t c{} ; c < columns ; c++)
+                    out[c] = operation(left_value, right_row[c]);
+            }
+        }
+    });
+}
+
+template<typename Operation>
+static void broadcast_in_place(Base_Matrix &target, const Base_Matrix &source, const Operation &operation, const char* name){ // target = operation(target, source), source is broadcast to the shape of target
+    MATRICES_RECORD(Element_Wise, target.get_rows() * target.get_columns(), 2 * target.get_rows() * target.get_columns() * sizeof(data_type) + source.get_rows() * source.get_columns() * sizeof(data_type));
+    size_t columns{}, rows{};
+    if(!broadcast_shape(target, source, columns, rows) || columns != target.get_columns() || rows != target.get_rows()){
+        std::cerr << "\nCannot " << name << " a " << source.get_rows() << " x " << source.get_columns() << " Base_Matrix to a " << target.get_rows() << " x " << target.get_columns() << " one... \n";
+        throw Base_Matrix();
+    }
+    target.detach(); // before the parallel loop, which must not copy
+    broadcast(target, source, target, operation);
+}
+
+template<typename Operation>
+static Base_Matrix broadcast_new(const Base_Matrix &left, const Base_Matrix &right, const Operation &operation, const char* name){ // operation(left, right) with the shape broadcast from both operands
+    size_t columns{}, rows{};
+    if(!broadcast_shape(left, right, columns, rows)){
+        std::cerr << "\nCannot " << name << " a " << right.get_rows() << " x " << right.get_columns() << " Base_Matrix to a " << left.get_rows() << " x " << left.get_columns() << " one... \n";
+        throw Base_Matrix();
+    }
+    MATRICES_RECORD(Element_Wise, rows * columns, (rows * columns + left.get_rows() * left.get_columns() + right.get_rows() * right.get_columns()) * sizeof(data_type));
+    Base_Matrix result(columns, rows, 0);
+    broadcast(left, right, result, operation);
+    return result;
+}
 
 // ========================================================================================================================================== constructors and destructor
-Base_Matrix::Base_Matrix(size_t columns, size_t rows, data_type init_value) : rows_of_values{nullptr}, columns{columns}, rows{rows}{ // default constructor
+Base_Matrix::Base_Matrix(size_t columns, size_t rows, data_type init_value) : rows_of_values{nullptr}, columns{columns}, rows{0}, row_capacity{rows}{ // default constructor
     if(columns < 1 || rows < 1){
         std::cerr << "\nDimensions cannot be smaller than 1... \n";
         throw Base_Matrix();
     }
-    rows_of_values = new Base_Vector[rows];
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = Base_Vector(columns, init_value);
+    rows_of_values = allocate_rows(row_capacity);
+    construct_rows(rows_of_values, rows, columns, [columns, init_value](Base_Vector* slot, size_t){ new(slot) Base_Vector(columns, init_value); }); // every row is constructed once, directly in its slot
+    this->rows = rows;
 }
 
-Base_Matrix::Base_Matrix(const std::initializer_list<Base_Vector> &init_list) : Base_Matrix(init_list.begin()[0].get_length(), init_list.size()){ // initializer list constructor
+Base_Matrix::Base_Matrix(const std::initializer_list<Base_Vector> &init_list) : rows_of_values{nullptr}, columns{init_list.begin()[0].get_length()}, rows{0}, row_capacity{init_list.size()}{ // initializer list constructor
     for(const auto &vec : init_list){
         if(vec.get_length() != columns){
             std::cerr << "\nLengths of the initializer lists vectors are not equal... \n";
             throw Base_Matrix();
         }
     }
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = init_list.begin()[r];
+    rows_of_values = allocate_rows(row_capacity);
+    try{
+        for( ; rows < row_capacity ; rows++)
+            new(&rows_of_values[rows]) Base_Vector(init_list.begin()[rows]);
+    }
+    catch(...){
+        release_rows(rows_of_values, rows);
+        throw;
+    }
 }
 
-Base_Matrix::Base_Matrix(const Base_Matrix &source) : Base_Matrix(source.columns, source.rows){ // copy constructor
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = source.rows_of_values[r];
+Base_Matrix::Base_Matrix(const Base_Matrix &source) : rows_of_values{nullptr}, columns{source.columns}, rows{0}, row_capacity{source.rows}{ // copy constructor, shares the rows in the copy on write mode
+    if(copy_on_write && source.rows_of_values != nullptr){
+        MATRICES_RECORD(Matrix_Copy, 0, 0);
+        storage_header(source.rows_of_values)->owners.fetch_add(1, std::memory_order_relaxed);
+        rows_of_values = source.rows_of_values;
+        rows = source.rows;
+        row_capacity = source.row_capacity;
+        mapping = source.mapping;
+        return;
+    }
+    MATRICES_RECORD(Matrix_Copy, 0, source.rows * source.columns * sizeof(data_type));
+    rows_of_values = allocate_rows(row_capacity);
+    construct_rows(rows_of_values, source.rows, columns, [&source](Base_Vector* slot, size_t r){ new(slot) Base_Vector(source.rows_of_values[r]); });
+    rows = source.rows;
 }
 
-Base_Matrix::Base_Matrix(Base_Matrix &&source) : rows_of_values{source.rows_of_values}, columns{source.columns}, rows{source.rows}{ // move contructor
+Base_Matrix::Base_Matrix(Base_Matrix &&source) noexcept : rows_of_values{source.rows_of_values}, columns{source.columns}, rows{source.rows}, row_capacity{source.row_capacity}, mapping{std::move(source.mapping)}{ // move contructor
+    MATRICES_RECORD(Matrix_Move, 0, 0);
     source.rows_of_values = nullptr;
+    source.rows = 0;
+    source.row_capacity = 0;
 }
 
 Base_Matrix::~Base_Matrix(){
-    delete[] rows_of_values;
+    release_rows(rows_of_values, rows);
+}
+
+Base_Vector* Base_Matrix::allocate_rows(size_t capacity){ // raw storage for rows with a single owner, nothing is constructed (static function)
+    char* memory = static_cast<char*>(::operator new(row_storage_offset + capacity * sizeof(Base_Vector)));
+    new(memory) Row_Storage_Header();
+    return reinterpret_cast<Base_Vector*>(memory + row_storage_offset);
+}
+
+void Base_Matrix::release_rows(Base_Vector* rows_of_values, size_t count) noexcept{ // drops one owner, the last one destroys the first count rows and frees the storage (static function)
+    if(rows_of_values == nullptr)
+        return;
+    Row_Storage_Header* header = storage_header(rows_of_values);
+    if(header->owners.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return; // still used by another matrix
+    for(size_t r{} ; r < count ; r++)
+        rows_of_values[r].~Base_Vector();
+    header->~Row_Storage_Header();
+    ::operator delete(static_cast<void*>(header));
+}
+
+bool Base_Matrix::is_shared() const{ // true if the rows are shared with another matrix
+    return rows_of_values != nullptr && storage_header(rows_of_values)->owners.load(std::memory_order_acquire) > 1;
+}
+
+void Base_Matrix::detach(){ // gives the matrix its own copy of shared rows, called before every mutation
+    if(!is_shared())
+        return;
+    MATRICES_RECORD(Matrix_Copy, 0, rows * columns * sizeof(data_type));
+    Base_Vector* own = allocate_rows(rows);
+    construct_rows(own, rows, columns, [this](Base_Vector* slot, size_t r){ new(slot) Base_Vector(rows_of_values[r]); });
+    release_rows(rows_of_values, rows);
+    rows_of_values = own;
+    row_capacity = rows;
+    mapping.reset(); // the copies own their values
+}
+
+void Base_Matrix::set_strassen_cutoff(size_t cutoff){ // products up to this size use the standard kernel (static function)
+    if(cutoff < 16){
+        std::cerr << "\nStrassen cutoff cannot be smaller than 16... \n";
+        throw Base_Matrix();
+    }
+    strassen_cutoff = cutoff;
 }
 
 // ========================================================================================================================================== values insertion methods
@@ -45,15 +380,43 @@ void Base_Matrix::insert_row(const Base_Vector &row, size_t pos){ // insert row
         std::cerr << "\nRow must be the same length as the number of columns for insertion to succedd... \n";
         throw Base_Matrix();
     }
-    Base_Matrix temp(*this);
-    delete[] rows_of_values;
-    rows_of_values = new Base_Vector[++rows]; // increase number of rows
-    for(size_t r{}, i{}; r < rows ; r++){
-        if(r != pos)
-            rows_of_values[r] = temp[i++];
-        else
-            rows_of_values[r] = row;
+    Base_Vector inserted(row); // copy first, the row may be one of the rows of this matrix
+    detach();
+    if(rows == row_capacity)
+        reserve_rows(2 * row_capacity + 1); // grow geometrically
+    if(pos == rows)
+        new(&rows_of_values[rows]) Base_Vector(std::move(inserted));
+    else{
+        new(&rows_of_values[rows]) Base_Vector(std::move(rows_of_values[rows - 1])); // the new slot is constructed, the rest is moved
+        for(size_t r{rows - 1} ; r > pos ; r--)
+            rows_of_values[r] = std::move(rows_of_values[r - 1]);
+        rows_of_values[pos] = std::move(inserted);
     }
+    rows++; // increase number of rows
+}
+
+void Base_Matrix::append_row(Base_Vector &&row){ // append row at the end, amortized constant time
+    if(row.get_length() != columns){
+        std::cerr << "\nRow must be the same length as the number of columns for insertion to succedd... \n";
+        throw Base_Matrix();
+    }
+    detach();
+    if(rows == row_capacity)
+        reserve_rows(2 * row_capacity + 1); // grow geometrically
+    new(&rows_of_values[rows]) Base_Vector(std::move(row));
+    rows++;
+}
+
+void Base_Matrix::reserve_rows(size_t capacity){ // preallocate space for rows
+    if(capacity <= row_capacity)
+        return;
+    detach();
+    Base_Vector* reserved = allocate_rows(capacity);
+    for(size_t r{} ; r < rows ; r++) // moving a Base_Vector only moves its pointer
+        new(&reserved[r]) Base_Vector(std::move(rows_of_values[r]));
+    release_rows(rows_of_values, rows);
+    rows_of_values = reserved;
+    row_capacity = capacity;
 }
 
 void Base_Matrix::delete_row(size_t pos){ // delete row
@@ -61,13 +424,10 @@ void Base_Matrix::delete_row(size_t pos){ // delete row
         std::cerr << "\nInvalid position during row deletion... \n";
         throw Base_Matrix();
     }
-    Base_Matrix temp(*this);
-    delete[] rows_of_values;
-    rows_of_values = new Base_Vector[--rows]; // decrease number of rows
-    for(size_t r{}, i{}; r < rows ; i++){
-        if(i != pos)
-            rows_of_values[r++] = temp[i];
-    }
+    detach();
+    for(size_t r{pos} ; r + 1 < rows ; r++) // close the gap, rows are moved not copied
+        rows_of_values[r] = std::move(rows_of_values[r + 1]);
+    rows_of_values[--rows].~Base_Vector(); // decrease number of rows, the slot becomes spare capacity
 }
 
 void Base_Matrix::insert_column(const Base_Vector &column, size_t pos){ // insert column
@@ -80,6 +440,7 @@ void Base_Matrix::insert_column(const Base_Vector &column, size_t pos){ // inser
         throw Base_Matrix();
     }
     
+    detach();
     columns++; // increase number of columns
     
     for(size_t r{} ; r < rows ; r++){
@@ -93,6 +454,7 @@ void Base_Matrix::delete_column(size_t pos){ // delete column
         throw Base_Matrix();
     }
     
+    detach();
     columns--; // decrease number of columns
     
     for(size_t r{} ; r < rows ; r++){
@@ -102,8 +464,8 @@ void Base_Matrix::delete_column(size_t pos){ // delete column
 
 // ========================================================================================================================================== display method and insertion operator
 std::ostream &operator<<(std::ostream &os, const Base_Matrix &base_matrix){ // stream insertion operator (friend function)
-    for(size_t r{} ; r < base_matrix.rows ; r++)
-        os << base_matrix.rows_of_values[r] << std::endl;
+    Matrix_Writer writer(os);
+    writer.write(base_matrix);
     return os;
 }
 
@@ -111,31 +473,172 @@ void Base_Matrix::display() const{ // display method
     std::cout << *this;
 }
 
+void Base_Matrix::display(const Output_Format &format) const{ // display method with the given precision, delimiter and summarization
+    Matrix_Writer writer(std::cout, format);
+    writer.write(*this);
+}
+
+// ========================================================================================================================================== binary input and output
+void Base_Matrix::save(const std::string &path) const{ // writes the matrix in the binary format
+    MATRICES_TIMED_SCOPE(Save);
+    MATRICES_RECORD(Save, 0, rows * columns * sizeof(data_type));
+    Binary_Header header{};
+    std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.version = binary_version;
+    header.header_size = sizeof(Binary_Header);
+    header.dtype = binary_dtype_double;
+    header.layout = binary_layout_row_major;
+    header.rows = rows;
+    header.columns = columns;
+    header.alignment = binary_alignment;
+    header.payload_offset = (sizeof(Binary_Header) + binary_alignment - 1) / binary_alignment * binary_alignment;
+    header.endianness = binary_endianness;
+    
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file){
+        std::cerr << "\nCannot open the file for writing... \n";
+        throw Base_Matrix();
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(uint64_t i{sizeof(header)} ; i < header.payload_offset ; i++) // padding up to the payload offset
+        file.put(0);
+    for(size_t r{} ; r < rows ; r++)
+        file.write(reinterpret_cast<const char*>(rows_of_values[r].data()), columns * sizeof(data_type));
+    if(!file){
+        std::cerr << "\nWriting the matrix to the file failed... \n";
+        throw Base_Matrix();
+    }
+}
+
+Base_Matrix Base_Matrix::load(const std::string &path){ // reads the matrix from the binary file
+    Base_Matrix loaded;
+    loaded.read_binary(path, false);
+    return loaded;
+}
+
+Base_Matrix Base_Matrix::map(const std::string &path){ // memory maps the binary file
+    Base_Matrix mapped;
+    mapped.read_binary(path, true);
+    return mapped;
+}
+
+void Base_Matrix::read_binary(const std::string &path, bool mapped){ // replaces the contents with the matrix stored in the file
+    MATRICES_TIMED_SCOPE(Load);
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if(descriptor < 0){
+        std::cerr << "\nCannot open the file for reading... \n";
+        throw Base_Matrix();
+    }
+    struct stat file_status{};
+    Binary_Header header{};
+    bool valid = fstat(descriptor, &file_status) == 0 && file_status.st_size >= 0 && pread(descriptor, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    uint64_t file_size = valid ? static_cast<uint64_t>(file_status.st_size) : 0;
+    valid = valid && std::memcmp(header.magic, binary_magic, sizeof(binary_magic)) == 0 && header.version == binary_version
+        && header.header_size == sizeof(Binary_Header) && header.dtype == binary_dtype_double && header.layout == binary_layout_row_major
+        && header.endianness == binary_endianness && header.rows > 0 && header.columns > 0
+        && header.alignment >= sizeof(data_type) && header.alignment % sizeof(data_type) == 0 && header.payload_offset % header.alignment == 0
+        && header.payload_offset >= sizeof(Binary_Header)
+        && header.columns <= SIZE_MAX / sizeof(data_type) / header.rows
+        && header.payload_offset <= file_size && header.rows * header.columns * sizeof(data_type) <= file_size - header.payload_offset; // no sum that could wrap
+    if(!valid){
+        close(descriptor);
+        std::cerr << "\nFile is not a valid binary matrix of this version... \n";
+        throw Base_Matrix();
+    }
+    
+    size_t row_bytes = header.columns * sizeof(data_type);
+    Base_Vector* new_rows = allocate_rows(header.rows);
+    size_t constructed{};
+    std::shared_ptr<void> new_mapping;
+    
+    if(mapped){
+        size_t mapping_length = header.payload_offset + header.rows * row_bytes;
+        void* address = mmap(nullptr, mapping_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0); // private mapping, writes never reach the file
+        close(descriptor);
+        if(address == MAP_FAILED){
+            release_rows(new_rows, 0);
+            std::cerr << "\nMemory mapping of the file failed... \n";
+            throw Base_Matrix();
+        }
+        new_mapping = std::shared_ptr<void>(address, [mapping_length](void* address){ munmap(address, mapping_length); });
+        data_type* payload = reinterpret_cast<data_type*>(static_cast<char*>(address) + header.payload_offset);
+        for( ; constructed < header.rows ; constructed++)
+            new(&new_rows[constructed]) Base_Vector(Base_Vector::view(payload + constructed * header.columns, header.columns));
+    }
+    else{
+        bool read_failed{false};
+        for( ; constructed < header.rows && !read_failed ; constructed++){
+            new(&new_rows[constructed]) Base_Vector(header.columns);
+            char* destination = reinterpret_cast<char*>(new_rows[constructed].data());
+            off_t offset = header.payload_offset + constructed * row_bytes;
+            for(size_t done{} ; done < row_bytes ; ){
+                ssize_t count = pread(descriptor, destination + done, row_bytes - done, offset + done);
+                if(count <= 0){
+                    read_failed = true;
+                    break;
+                }
+                done += count;
+            }
+        }
+        close(descriptor);
+        if(read_failed){
+            release_rows(new_rows, constructed);
+            std::cerr << "\nReading the matrix from the file failed... \n";
+            throw Base_Matrix();
+        }
+    }
+    
+    release_rows(rows_of_values, rows);
+    rows_of_values = new_rows;
+    rows = header.rows;
+    row_capacity = header.rows;
+    columns = header.columns;
+    mapping = std::move(new_mapping);
+}
+
 // ========================================================================================================================================== operators
 Base_Matrix &Base_Matrix::operator=(const Base_Matrix &source){ // copy assignment
+    MATRICES_RECORD(Matrix_Copy, 0, source.rows * source.columns * sizeof(data_type));
     if(&source == this)
         return *this;
-    delete[] rows_of_values;
-    columns = source.columns;
-    rows = source.rows;
-    rows_of_values = new Base_Vector[rows];
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = source.rows_of_values[r];
+    if(rows == source.rows && columns == source.columns && !copy_on_write && !is_shared()){ // same shape, the values are copied into the existing rows
+        for(size_t r{} ; r < rows ; r++)
+            rows_of_values[r] = source.rows_of_values[r];
+    }
+    else{ // the copy shares the rows of source in the copy on write mode
+        Base_Matrix copy(source);
+        std::swap(rows_of_values, copy.rows_of_values);
+        std::swap(rows, copy.rows);
+        std::swap(row_capacity, copy.row_capacity);
+        std::swap(mapping, copy.mapping);
+        columns = source.columns;
+        return *this;
+    }
+    mapping.reset(); // the copy owns all of its rows
     return *this;
 }
 
-Base_Matrix &Base_Matrix::operator=(Base_Matrix &&source){ // move assignment
+Base_Matrix &Base_Matrix::operator=(Base_Matrix &&source){ // move assignment, virtual so a Vector assigned through the base still checks the shape
+    move_from(std::move(source));
+    return *this;
+}
+
+void Base_Matrix::move_from(Base_Matrix &&source) noexcept{ // takes the rows of source, the shape is not checked
+    MATRICES_RECORD(Matrix_Move, 0, 0);
     if(&source == this)
-        return *this;
-    delete[] rows_of_values;
+        return;
+    release_rows(rows_of_values, rows);
     columns = source.columns;
     rows = source.rows;
+    row_capacity = source.row_capacity;
     rows_of_values = source.rows_of_values;
+    mapping = std::move(source.mapping);
     source.rows_of_values = nullptr;
-    return *this;
+    source.rows = 0;
+    source.row_capacity = 0;
 }
 
-Base_Vector &Base_Matrix::operator[](size_t r) const{ // subscript operator
+const Base_Vector &Base_Matrix::operator[](size_t r) const{ // subscript operator, never copies
     if(r > rows){
         std::cerr << "\nIndex out of bounds... \n";
         throw Base_Matrix();
@@ -143,25 +646,30 @@ Base_Vector &Base_Matrix::operator[](size_t r) const{ // subscript operator
     return rows_of_values[r];
 }
 
+Base_Vector &Base_Matrix::operator[](size_t r){ // subscript operator, detaches shared rows first
+    if(r > rows){
+        std::cerr << "\nIndex out of bounds... \n";
+        throw Base_Matrix();
+    }
+    detach();
+    return rows_of_values[r];
+}
+
 Base_Matrix Base_Matrix::operator-() const{ // minus operator
     Base_Matrix negation(*this);
-    for(size_t r{} ; r < rows ; r++)
-        negation[r] = -negation[r];
+    negation *= -1; // in place, no temporary rows
     return negation;
 }
 
 void Base_Matrix::operator+=(data_type k){ // += double
+    MATRICES_RECORD(Element_Wise, rows * columns, 2 * rows * columns * sizeof(data_type));
+    detach();
     for(size_t r{} ; r < rows ; r++)
         rows_of_values[r] += k;
 }
 
-void Base_Matrix::operator+=(const Base_Matrix &base_matrix){ // += base_matrix
-    if(rows != base_matrix.rows || columns != base_matrix.columns){
-        std::cerr << "\nCannot add Base_Matrixs of different sizes... \n";
-        throw Base_Matrix();
-    }
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] += base_matrix[r];
+void Base_Matrix::operator+=(const Base_Matrix &base_matrix){ // += base_matrix, a 1 x columns or rows x 1 base_matrix is broadcast
+    broadcast_in_place(*this, base_matrix, [](data_type left, data_type right){ return left + right; }, "add");
 }
 
 Base_Matrix Base_Matrix::operator+(data_type k) const{ // + double
@@ -170,24 +678,19 @@ Base_Matrix Base_Matrix::operator+(data_type k) const{ // + double
     return sum;
 }
 
-Base_Matrix Base_Matrix::operator+(const Base_Matrix &base_matrix) const{ // + base_matrix
-    Base_Matrix sum(*this);
-    sum += base_matrix;
-    return sum;
+Base_Matrix Base_Matrix::operator+(const Base_Matrix &base_matrix) const{ // + base_matrix, dimensions of size 1 of either side are broadcast
+    return broadcast_new(*this, base_matrix, [](data_type left, data_type right){ return left + right; }, "add");
 }
 
 void Base_Matrix::operator-=(data_type k){ // -= double
+    MATRICES_RECORD(Element_Wise, rows * columns, 2 * rows * columns * sizeof(data_type));
+    detach();
     for(size_t r{} ; r < rows ; r++)
         rows_of_values[r] -= k;
 }
 
-void Base_Matrix::operator-=(const Base_Matrix &base_matrix){ // -= base_matrix
-    if(rows != base_matrix.rows || columns != base_matrix.columns){
-        std::cerr << "\nCannot subtract Base_Matrixs of different sizes... \n";
-        throw Base_Matrix();
-    }
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] -= base_matrix[r];
+void Base_Matrix::operator-=(const Base_Matrix &base_matrix){ // -= base_matrix, a 1 x columns or rows x 1 base_matrix is broadcast
+    broadcast_in_place(*this, base_matrix, [](data_type left, data_type right){ return left - right; }, "subtract");
 }
     
 Base_Matrix Base_Matrix::operator-(data_type k) const{ // - double
@@ -196,13 +699,13 @@ Base_Matrix Base_Matrix::operator-(data_type k) const{ // - double
     return sum;
 }
     
-Base_Matrix Base_Matrix::operator-(const Base_Matrix &base_matrix) const{ // - base_matrix
-    Base_Matrix sum(*this);
-    sum -= base_matrix;
-    return sum;
+Base_Matrix Base_Matrix::operator-(const Base_Matrix &base_matrix) const{ // - base_matrix, dimensions of size 1 of either side are broadcast
+    return broadcast_new(*this, base_matrix, [](data_type left, data_type right){ return left - right; }, "subtract");
 }
 
 void Base_Matrix::operator*=(data_type k){ // *= double
+    MATRICES_RECORD(Element_Wise, rows * columns, 2 * rows * columns * sizeof(data_type));
+    detach();
     for(size_t r{} ; r < rows ; r++)
         rows_of_values[r] *= k;
 }
@@ -222,17 +725,96 @@ Base_Matrix operator*(const Base_Matrix &left_matrice, const Base_Matrix &right_
         std::cerr << "\nLeft side's amount of columns is not equal to right side's amount of rows... \n"; 
         throw Base_Matrix();
     }
-    size_t result_columns = ( (left_matrice.columns < right_matrice.columns) ? left_matrice.columns : right_matrice.columns);
-    size_t result_rows = ( (left_matrice.rows < right_matrice.rows) ? left_matrice.rows : right_matrice.rows);
-    size_t iterations_per_element = left_matrice.columns; // iterations per result matrice element
+    return Base_Matrix::multiply(left_matrice, right_matrice, Base_Matrix::multiplication_policy);
+}
+
+Base_Matrix Base_Matrix::multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Multiplication_Policy policy){ // left * right with the given policy (static function)
+    if(left_matrice.columns != right_matrice.rows){
+        std::cerr << "\nLeft side's amount of columns is not equal to right side's amount of rows... \n"; 
+        throw Base_Matrix();
+    }
+    Base_Matrix product(right_matrice.columns, left_matrice.rows, 0); // result has as many rows as the left side and as many columns as the right side
+    size_t n = left_matrice.rows;
+    bool square = left_matrice.columns == n && right_matrice.columns == n;
+    if(policy == Strassen_Winograd && square && n > strassen_cutoff){
+        MATRICES_TIMED_SCOPE(Multiply);
+        MATRICES_RECORD(Multiply, 2 * n * n * n, 4 * n * n * sizeof(data_type)); // flops of the standard product, so that the rates are comparable
+        Strassen::multiply(left_matrice, right_matrice, product, strassen_cutoff);
+    }
+    else
+        Base_Matrix::multiply_add(left_matrice, right_matrice, product);
+    return product;
+}
+
+void Base_Matrix::multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result, Multiplication_Policy policy){ // result = left * right into the existing storage of result, no allocation (static function)
+    if(left_matrice.columns != right_matrice.rows){
+        std::cerr << "\nLeft side's amount of columns is not equal to right side's amount of rows... \n"; 
+        throw Base_Matrix();
+    }
+    if(result.rows != left_matrice.rows || result.columns != right_matrice.columns){
+        std::cerr << "\nResult of the multiplication has invalid dimensions... \n"; 
+        throw Base_Matrix();
+    }
+    if(&result == &left_matrice || &result == &right_matrice){
+        std::cerr << "\nResult of the multiplication cannot be one of its operands... \n"; 
+        throw Base_Matrix();
+    }
+    result.detach();
+    size_t n = left_matrice.rows;
+    bool square = left_matrice.columns == n && right_matrice.columns == n;
+    if(policy == Strassen_Winograd && square && n > strassen_cutoff){
+        MATRICES_TIMED_SCOPE(Multiply);
+        MATRICES_RECORD(Multiply, 2 * n * n * n, 4 * n * n * sizeof(data_type)); // flops of the standard product, so that the rates are comparable
+        Strassen::multiply(left_matrice, right_matrice, result, strassen_cutoff);
+        return;
+    }
+    for(size_t r{} ; r < result.rows ; r++)
+        std::fill(result.rows_of_values[r].data(), result.rows_of_values[r].data() + result.columns, 0.0);
+    Base_Matrix::multiply_add(left_matrice, right_matrice, result);
+}
+
+void Base_Matrix::multiply_add(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result){ // result += left * right, cache blocked and parallel (static function)
+    MATRICES_TIMED_SCOPE(Multiply);
+    MATRICES_RECORD(Multiply, 2 * left_matrice.rows * left_matrice.columns * right_matrice.columns,
+        (left_matrice.rows * left_matrice.columns + right_matrice.rows * right_matrice.columns + 2 * result.rows * result.columns) * sizeof(data_type));
+    if(left_matrice.columns != right_matrice.rows){
+        std::cerr << "\nLeft side's amount of columns is not equal to right side's amount of rows... \n"; 
+        throw Base_Matrix();
+    }
+    if(result.rows != left_matrice.rows || result.columns != right_matrice.columns){
+        std::cerr << "\nResult of the multiplication has invalid dimensions... \n"; 
+        throw Base_Matrix();
+    }
+    if(&result == &left_matrice || &result == &right_matrice){
+        std::cerr << "\nResult of the multiplication cannot be one of its operands... \n"; 
+        throw Base_Matrix();
+    }
+    result.detach(); // before the parallel loop, which must not copy
     
-    Base_Matrix product(result_columns, result_rows, 0);
+    const size_t block_inner{128}; // block of the shared dimension, together with the column block it keeps the used part of the right side in cache
+    const size_t block_columns{256};
+    size_t inner = left_matrice.columns;
+    size_t result_columns = result.columns;
+    size_t rows_per_chunk = (1 << 18) / (inner * result_columns + 1) + 1; // at least about 256k multiply-adds per thread
     
-    for(size_t i{} ; i < result_rows ; i++)
-        for(size_t j{} ; j < result_columns ; j++)
-            for(size_t k{} ; k < iterations_per_element ; k++)
-                product[i][j] += left_matrice[i][k] * right_matrice[k][j];
-    return product;
+    Parallel::for_range(0, result.rows, rows_per_chunk, [&](size_t first_row, size_t last_row){
+        for(size_t kk{} ; kk < inner ; kk += block_inner){
+            size_t k_end = (kk + block_inner < inner) ? kk + block_inner : inner;
+            for(size_t jj{} ; jj < result_columns ; jj += block_columns){
+                size_t j_end = (jj + block_columns < result_columns) ? jj + block_columns : result_columns;
+                for(size_t i{first_row} ; i < last_row ; i++){
+                    data_type* out = result.rows_of_values[i].data();
+                    const data_type* left_row = left_matrice.rows_of_values[i].data();
+                    for(size_t k{kk} ; k < k_end ; k++){
+                        data_type factor = left_row[k];
+                        const data_type* right_row = right_matrice.rows_of_values[k].data();
+                        for(size_t j{jj} ; j < j_end ; j++)
+                            out[j] += factor * right_row[j];
+                    }
+                }
+            }
+        }
+    });
 }
 
 void Base_Matrix::operator*=(const Base_Matrix &base_matrix){ // *= base_matrix, matrix multiplication
@@ -240,10 +822,12 @@ void Base_Matrix::operator*=(const Base_Matrix &base_matrix){ // *= base_matrix,
 }
 
 void Base_Matrix::operator/=(data_type k){ // /= double
+    MATRICES_RECORD(Element_Wise, rows * columns, 2 * rows * columns * sizeof(data_type));
     if(k == 0){
         std::cerr << "\nCannot divide by 0... \n"; 
         throw Base_Matrix();
     }
+    detach();
     for(size_t r{} ; r < rows ; r++)
         rows_of_values[r] /= k;
 }
@@ -254,18 +838,214 @@ Base_Matrix Base_Matrix::operator/(data_type k) const{ // / double
     return sum;
 }
 
+void Base_Matrix::operator/=(const Base_Matrix &base_matrix){ // /= base_matrix element wise, a 1 x columns or rows x 1 base_matrix is broadcast
+    broadcast_in_place(*this, base_matrix, [](data_type left, data_type right){ return left / right; }, "divide");
+}
+
+Base_Matrix Base_Matrix::operator/(const Base_Matrix &base_matrix) const{ // / base_matrix element wise, dimensions of size 1 of either side are broadcast
+    return broadcast_new(*this, base_matrix, [](data_type left, data_type right){ return left / right; }, "divide");
+}
+
 // ========================================================================================================================================== other mathematical operations
-Base_Matrix Base_Matrix::element_wise_product(const Base_Matrix &left_vector, const Base_Matrix &right_vector){ // hadamard product, or element wise product (static function)
-    Base_Matrix product(left_vector);
-    for(size_t r{} ; r < left_vector.rows ; r++)
-        product[r] = Base_Vector::element_wise_product(left_vector[r], right_vector[r]);
-    return product;
+Base_Matrix Base_Matrix::element_wise_product(const Base_Matrix &left_vector, const Base_Matrix &right_vector){ // hadamard product, or element wise product, dimensions of size 1 are broadcast (static function)
+    return broadcast_new(left_vector, right_vector, [](data_type left, data_type right){ return left * right; }, "multiply");
+}
+
+Base_Matrix Base_Matrix::element_wise_quotient(const Base_Matrix &left_vector, const Base_Matrix &right_vector){ // element wise division, dimensions of size 1 are broadcast (static function)
+    return broadcast_new(left_vector, right_vector, [](data_type left, data_type right){ return left / right; }, "divide");
+}
+
+void Base_Matrix::element_wise_multiply(const Base_Matrix &base_matrix){ // in place hadamard product, a 1 x columns or rows x 1 base_matrix is broadcast
+    broadcast_in_place(*this, base_matrix, [](data_type left, data_type right){ return left * right; }, "multiply");
 }
 
 Base_Matrix Base_Matrix::transpone() const{ // transpone
+    MATRICES_TIMED_SCOPE(Transpone);
+    MATRICES_RECORD(Transpone, 0, 2 * rows * columns * sizeof(data_type));
     Base_Matrix transponed(rows, columns, 0); // rows and columns are switched
     for(size_t r{} ; r < rows ; r++)
         for(size_t c{} ; c < columns ; c++)
             transponed[c][r] = rows_of_values[r][c];
     return transponed;
+}
+
+// ========================================================================================================================================== reductions
+data_type Base_Matrix::sum() const{ // pairwise sum, the same for any thread count
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> row_results = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::sum(values, count, parallel); });
+    return Reduction::sum(row_results.data(), rows, false);
+}
+
+data_type Base_Matrix::mean() const{ // arithmetic mean
+    return sum() / (rows * columns);
+}
+
+data_type Base_Matrix::min() const{ // smallest value
+    std::pair<size_t, size_t> position = argmin();
+    return rows_of_values[position.first][position.second];
+}
+
+data_type Base_Matrix::max() const{ // largest value
+    std::pair<size_t, size_t> position = argmax();
+    return rows_of_values[position.first][position.second];
+}
+
+std::pair<size_t, size_t> Base_Matrix::argmin() const{ // row and column of the first smallest value (in row major order)
+    std::vector<size_t> columns_of_min = row_argmin();
+    size_t best{};
+    for(size_t r{1} ; r < rows ; r++)
+        if(rows_of_values[r][columns_of_min[r]] < rows_of_values[best][columns_of_min[best]])
+            best = r;
+    return {best, columns_of_min[best]};
+}
+
+std::pair<size_t, size_t> Base_Matrix::argmax() const{ // row and column of the first largest value (in row major order)
+    std::vector<size_t> columns_of_max = row_argmax();
+    size_t best{};
+    for(size_t r{1} ; r < rows ; r++)
+        if(rows_of_values[r][columns_of_max[r]] > rows_of_values[best][columns_of_max[best]])
+            best = r;
+    return {best, columns_of_max[best]};
+}
+
+data_type Base_Matrix::frobenius_norm() const{ // square root of the sum of squares
+    MATRICES_RECORD(Reduce, 2 * rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> row_results = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::sum_of_squares(values, count, 1, parallel); });
+    data_type squares = Reduction::sum(row_results.data(), rows, false);
+    if(std::isfinite(squares) && squares > 1e-280) // the common case needs a single pass
+        return std::sqrt(squares);
+
+    std::vector<data_type> row_largest = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return std::fabs(values[Reduction::index_of_max_absolute(values, count, parallel)]); });
+    data_type largest = row_largest[Reduction::index_of_max(row_largest.data(), rows, false)];
+    if(largest == 0 || !std::isfinite(largest))
+        return largest;
+    bool subnormal = !std::isfinite(1 / largest); // 1 / largest overflows, an exact power of two brings the values to the normal range instead
+    data_type scale = subnormal ? std::ldexp(data_type(1), 600) : 1 / largest; // rescaled so that the squares neither overflow nor underflow
+    row_results = reduce_rows(*this, [scale](const data_type* values, size_t count, bool parallel){ return Reduction::sum_of_squares(values, count, scale, parallel); });
+    data_type scaled_norm = std::sqrt(Reduction::sum(row_results.data(), rows, false));
+    return subnormal ? scaled_norm / scale : largest * scaled_norm;
+}
+
+data_type Base_Matrix::norm_1() const{ // largest sum of the absolute values of a column
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> column_results = sum_columns(*this, [](data_type value){ return std::fabs(value); });
+    return column_results[Reduction::index_of_max(column_results.data(), columns, false)];
+}
+
+data_type Base_Matrix::norm_inf() const{ // largest sum of the absolute values of a row
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> row_results = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::sum_of_absolutes(values, count, parallel); });
+    return row_results[Reduction::index_of_max(row_results.data(), rows, false)];
+}
+
+data_type Base_Matrix::trace() const{ // sum of the diagonal
+    if(rows != columns){
+        std::cerr << "\nTrace is defined only for square matrices... \n";
+        throw Base_Matrix();
+    }
+    std::vector<data_type> diagonal(rows);
+    for(size_t r{} ; r < rows ; r++)
+        diagonal[r] = rows_of_values[r].data()[r];
+    return Reduction::sum(diagonal.data(), rows, false);
+}
+
+data_type Base_Matrix::dot(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice){ // sum of the element wise product, vectors of the same length can differ in orientation (static function)
+    size_t count = left_matrice.rows * left_matrice.columns;
+    MATRICES_RECORD(Reduce, 2 * count, 2 * count * sizeof(data_type));
+    if(left_matrice.rows == right_matrice.rows && left_matrice.columns == right_matrice.columns){
+        std::vector<data_type> row_results(left_matrice.rows);
+        if(left_matrice.rows == 1)
+            row_results[0] = Reduction::dot(left_matrice.rows_of_values[0].data(), right_matrice.rows_of_values[0].data(), count);
+        else{
+            Parallel::for_range(0, left_matrice.rows, reduction_chunk / left_matrice.columns + 1, [&](size_t first_row, size_t last_row){
+                for(size_t r{first_row} ; r < last_row ; r++)
+                    row_results[r] = Reduction::dot(left_matrice.rows_of_values[r].data(), right_matrice.rows_of_values[r].data(), left_matrice.columns, false);
+            });
+        }
+        return Reduction::sum(row_results.data(), left_matrice.rows, false);
+    }
+
+    bool both_vectors = (left_matrice.rows == 1 || left_matrice.columns == 1) && (right_matrice.rows == 1 || right_matrice.columns == 1);
+    if(!both_vectors || count != right_matrice.rows * right_matrice.columns){
+        std::cerr << "\nDot product possible only for matrices of the same size or vectors of the same length... \n";
+        throw Base_Matrix();
+    }
+    auto contiguous = [count](const Base_Matrix &vector, std::vector<data_type> &buffer) -> const data_type*{ // values of a row or column vector in one array
+        if(vector.rows == 1)
+            return vector.rows_of_values[0].data();
+        buffer.resize(count);
+        for(size_t r{} ; r < count ; r++)
+            buffer[r] = vector.rows_of_values[r].data()[0];
+        return buffer.data();
+    };
+    std::vector<data_type> left_buffer, right_buffer;
+    return Reduction::dot(contiguous(left_matrice, left_buffer), contiguous(right_matrice, right_buffer), count);
+}
+
+Base_Matrix Base_Matrix::row_sums() const{ // column with the sum of every row
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> row_results = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::sum(values, count, parallel); });
+    Base_Matrix sums(1, rows, 0);
+    for(size_t r{} ; r < rows ; r++)
+        sums.rows_of_values[r].data()[0] = row_results[r];
+    return sums;
+}
+
+Base_Matrix Base_Matrix::column_sums() const{ // row with the sum of every column
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> column_results = sum_columns(*this, [](data_type value){ return value; });
+    Base_Matrix sums(columns, 1, 0);
+    std::memcpy(sums.rows_of_values[0].data(), column_results.data(), columns * sizeof(data_type));
+    return sums;
+}
+
+Base_Matrix Base_Matrix::row_means() const{ // column with the mean of every row
+    Base_Matrix means = row_sums();
+    means /= columns;
+    return means;
+}
+
+Base_Matrix Base_Matrix::column_means() const{ // row with the mean of every column
+    Base_Matrix means = column_sums();
+    means /= rows;
+    return means;
+}
+
+Base_Matrix Base_Matrix::row_norms() const{ // column with the euclidean norm of every row
+    MATRICES_RECORD(Reduce, 2 * rows * columns, rows * columns * sizeof(data_type));
+    std::vector<data_type> row_results = reduce_rows(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::euclidean_norm(values, count, parallel); });
+    Base_Matrix norms(1, rows, 0);
+    for(size_t r{} ; r < rows ; r++)
+        norms.rows_of_values[r].data()[0] = row_results[r];
+    return norms;
+}
+
+Base_Matrix Base_Matrix::column_norms() const{ // row with the euclidean norm of every column
+    MATRICES_RECORD(Reduce, 2 * rows * columns, rows * columns * sizeof(data_type));
+    std::vector<Scaled_Squares> column_results = reduce_columns<Scaled_Squares>(*this, [](Scaled_Squares &squares, data_type value){ squares.add(value); },
+        [](Scaled_Squares &squares, const Scaled_Squares &other){ squares.combine(other); });
+    Base_Matrix norms(columns, 1, 0);
+    for(size_t c{} ; c < columns ; c++)
+        norms.rows_of_values[0].data()[c] = column_results[c].norm();
+    return norms;
+}
+
+std::vector<size_t> Base_Matrix::row_argmin() const{ // column index of the first smallest value of every row
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    return reduce_rows<size_t>(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::index_of_min(values, count, parallel); });
+}
+
+std::vector<size_t> Base_Matrix::row_argmax() const{ // column index of the first largest value of every row
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    return reduce_rows<size_t>(*this, [](const data_type* values, size_t count, bool parallel){ return Reduction::index_of_max(values, count, parallel); });
+}
+
+std::vector<size_t> Base_Matrix::column_argmin() const{ // row index of the first smallest value of every column
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    return search_columns(*this, [](data_type value, data_type best){ return value < best; });
+}
+
+std::vector<size_t> Base_Matrix::column_argmax() const{ // row index of the first largest value of every column
+    MATRICES_RECORD(Reduce, rows * columns, rows * columns * sizeof(data_type));
+    return search_columns(*this, [](data_type value, data_type best){ return value > best; });
 }
\ No newline at end of file
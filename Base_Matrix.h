@@ -5,33 +5,77 @@
 // Base_Matrix is the class that provides a foundation of the Matrice and Vector classes
 // Base_Matrix provides all the common functionalities of Matrice and Vector
 
+// Base_Matrix can be saved in a versioned binary format and loaded back, either by reading the file or by memory mapping it
+// matrix multiplication uses the cache blocked standard product by default, the Strassen-Winograd policy switches large square products to Strassen
+// (see Strassen.h for the accuracy trade-off), products that are not square or not bigger than the cutoff always use the standard kernel
+// in the copy on write mode (off by default) a copy shares the rows of its source, a reference counted storage, until one of them is modified
+// every mutation (non const operator[], compound operators, insertions, deletions, products into it) detaches the matrix first,
+// so reading through const references or const methods never copies, while reading through a non const operator[] does
+// the storage can be shared across threads for reading, but a matrix has to be detached (or only read) before a parallel loop writes into it
+// the element wise operations broadcast like NumPy: a 1 x columns operand is repeated for every row, a rows x 1 operand for every column
+// the broadcast operand is read in place, it is never expanded to the full size, and the in place operators never allocate
+
+// binary format: 64 byte header (magic "MATRICES", version, header size, dtype, layout, rows, columns, alignment, payload offset, endianness marker)
+// followed by the raw row major payload of doubles, starting at the payload offset which is a multiple of the alignment
+
 #include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "Base_Vector.h"
 
 typedef double data_type;
 
+struct Output_Format;
+
 class Base_Matrix{
+public:
+    enum Multiplication_Policy{ Standard, Strassen_Winograd };
+
 protected:
     Base_Vector* rows_of_values;
     size_t columns;
     size_t rows;
+    size_t row_capacity; // number of allocated rows, rows beyond the "rows" count are spare slots for appending
+    std::shared_ptr<void> mapping; // keeps the memory mapped file alive while rows are views into it
+    
+    static Multiplication_Policy multiplication_policy; // policy used by the multiplication operators
+    static size_t strassen_cutoff; // size at which the Strassen recursion falls through to the standard kernel
+    static bool copy_on_write; // copies share the rows until one of them is modified
+    
+    void read_binary(const std::string &path, bool mapped); // replaces the contents with the matrix stored in the file
+    void move_from(Base_Matrix &&source) noexcept; // takes the rows of source, the shape is not checked
     
 public:
 // ========================================================================================================================================== constructors and destructor
     Base_Matrix(size_t columns = 1, size_t rows = 1, data_type init_value = 0); // default constructor
     Base_Matrix(const std::initializer_list<Base_Vector> &init_list); // initializer list constructor
     Base_Matrix(const Base_Matrix &source); // copy constructor
-    Base_Matrix(Base_Matrix &&source); // move contructor
+    Base_Matrix(Base_Matrix &&source) noexcept; // move contructor
     virtual ~Base_Matrix();
     
 // ========================================================================================================================================== getters and setters
     virtual size_t get_columns() const{ return columns; }
     virtual size_t get_rows() const{ return rows; }
-    virtual Base_Vector* get_ptr() { return rows_of_values; };
-    virtual void set_ptr(Base_Vector* ptr) { rows_of_values = ptr; };
+    virtual size_t get_row_capacity() const{ return row_capacity; }
+    virtual Base_Vector* get_ptr() { detach(); return rows_of_values; }; // detaches shared rows first, a parallel loop writes through a pointer fetched once before it, never through the non const operator[]
+    static Base_Vector* allocate_rows(size_t capacity); // raw storage for rows with a single owner, nothing is constructed
+    static void release_rows(Base_Vector* rows_of_values, size_t count) noexcept; // drops one owner, the last one destroys the first count rows and frees the storage
+    virtual void set_ptr(Base_Vector* ptr) { rows_of_values = ptr; }; // the storage has to come from allocate_rows
+    static Multiplication_Policy get_multiplication_policy() { return multiplication_policy; }
+    static void set_multiplication_policy(Multiplication_Policy policy) { multiplication_policy = policy; } // not thread safe, meant to be set once at start up
+    static size_t get_strassen_cutoff() { return strassen_cutoff; }
+    static void set_strassen_cutoff(size_t cutoff); // products up to this size use the standard kernel
+    static bool is_copy_on_write() { return copy_on_write; }
+    static void set_copy_on_write(bool enabled) { copy_on_write = enabled; } // affects the copies made afterwards, not thread safe, meant to be set once at start up
+    bool is_shared() const; // true if the rows are shared with another matrix
+    void detach(); // gives the matrix its own copy of shared rows, called before every mutation
     
 // ========================================================================================================================================== values insertion methods
     virtual void insert_row(const Base_Vector &row, size_t pos); // insert row
+    virtual void append_row(Base_Vector &&row); // append row at the end, amortized constant time
+    virtual void reserve_rows(size_t capacity); // preallocate space for rows, so that appending does not reallocate
     virtual void delete_row(size_t pos); // delete row
     
     virtual void insert_column(const Base_Vector &column, size_t pos); // insert column
@@ -40,36 +84,75 @@ public:
 // ========================================================================================================================================== display method and insertion operator
     friend std::ostream &operator<<(std::ostream &os, const Base_Matrix &base_matrix); // stream insertion operator (friend function)
     virtual void display() const; // display method
+    virtual void display(const Output_Format &format) const; // display method with the given precision, delimiter and summarization
+    
+// ========================================================================================================================================== binary input and output
+    virtual void save(const std::string &path) const; // writes the matrix in the binary format
+    static Base_Matrix load(const std::string &path); // reads the matrix from the binary file
+    static Base_Matrix map(const std::string &path); // memory maps the binary file, rows are backed directly by the file (writes stay private to the process)
+    bool is_mapped() const { return mapping != nullptr; } // true if at least part of the data is still backed by a memory mapped file
 
 // ========================================================================================================================================== operators
     virtual Base_Matrix &operator=(const Base_Matrix &source); // copy assignment
-    virtual Base_Matrix &operator=(Base_Matrix &&source); // move assignment
+    virtual Base_Matrix &operator=(Base_Matrix &&source); // move assignment, virtual so a Vector assigned through the base still checks the shape
     
-    virtual Base_Vector &operator[](size_t r) const; // subscript operator
+    virtual const Base_Vector &operator[](size_t r) const; // subscript operator, never copies
+    virtual Base_Vector &operator[](size_t r); // subscript operator, detaches shared rows first
     virtual Base_Matrix operator-() const; // minus operator
     
     virtual void operator+=(data_type k); // += double
-    virtual void operator+=(const Base_Matrix &base_matrix); // += base_matrix
+    virtual void operator+=(const Base_Matrix &base_matrix); // += base_matrix, a 1 x columns or rows x 1 base_matrix is broadcast
     virtual Base_Matrix operator+(data_type k) const; // + double
-    virtual Base_Matrix operator+(const Base_Matrix &base_matrix) const; // + base_matrix
+    virtual Base_Matrix operator+(const Base_Matrix &base_matrix) const; // + base_matrix, dimensions of size 1 of either side are broadcast
     
     virtual void operator-=(data_type k); // -= double
-    virtual void operator-=(const Base_Matrix &base_matrix); // -= base_matrix
+    virtual void operator-=(const Base_Matrix &base_matrix); // -= base_matrix, a 1 x columns or rows x 1 base_matrix is broadcast
     virtual Base_Matrix operator-(data_type k) const; // - double
-    virtual Base_Matrix operator-(const Base_Matrix &base_matrix) const; // - base_matrix
+    virtual Base_Matrix operator-(const Base_Matrix &base_matrix) const; // - base_matrix, dimensions of size 1 of either side are broadcast
 
     virtual void operator*=(data_type k); // *= double
     virtual Base_Matrix operator*(data_type k) const; // * double
     friend Base_Matrix operator*(data_type k, const Base_Matrix &base_matrix); // double * base_matrix (friend function)
     friend Base_Matrix operator*(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice); // base_matrix * base_matrix, matrix multiplication (friend function)
     virtual void operator*=(const Base_Matrix &base_matrix); // *= base_matrix, matrix multiplication
+    static void multiply_add(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result); // result += left * right, cache blocked and parallel (static function)
+    static Base_Matrix multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Multiplication_Policy policy); // left * right with the given policy (static function)
+    static void multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result, Multiplication_Policy policy); // result = left * right into the existing storage of result, no allocation (static function)
     
     virtual void operator/=(data_type k); // /= double
     virtual Base_Matrix operator/(data_type k) const; // / double
+    virtual void operator/=(const Base_Matrix &base_matrix); // /= base_matrix element wise, a 1 x columns or rows x 1 base_matrix is broadcast
+    virtual Base_Matrix operator/(const Base_Matrix &base_matrix) const; // / base_matrix element wise, dimensions of size 1 of either side are broadcast
     
 // ========================================================================================================================================== other mathematical operations
-    static Base_Matrix element_wise_product(const Base_Matrix &left_vector, const Base_Matrix &right_vector); // hadamard product, or element wise product (static function)
+    static Base_Matrix element_wise_product(const Base_Matrix &left_vector, const Base_Matrix &right_vector); // hadamard product, or element wise product, dimensions of size 1 are broadcast (static function)
+    static Base_Matrix element_wise_quotient(const Base_Matrix &left_vector, const Base_Matrix &right_vector); // element wise division, dimensions of size 1 are broadcast (static function)
+    virtual void element_wise_multiply(const Base_Matrix &base_matrix); // in place hadamard product, a 1 x columns or rows x 1 base_matrix is broadcast
     virtual Base_Matrix transpone() const; // transpone
+    
+// ========================================================================================================================================== reductions
+    virtual data_type sum() const; // pairwise sum, the same for any thread count
+    virtual data_type mean() const; // arithmetic mean
+    virtual data_type min() const; // smallest value
+    virtual data_type max() const; // largest value
+    virtual std::pair<size_t, size_t> argmin() const; // row and column of the first smallest value (in row major order)
+    virtual std::pair<size_t, size_t> argmax() const; // row and column of the first largest value (in row major order)
+    virtual data_type frobenius_norm() const; // square root of the sum of squares
+    virtual data_type norm_1() const; // largest sum of the absolute values of a column
+    virtual data_type norm_inf() const; // largest sum of the absolute values of a row
+    virtual data_type trace() const; // sum of the diagonal
+    static data_type dot(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice); // sum of the element wise product, vectors of the same length can differ in orientation (static function)
+    
+    virtual Base_Matrix row_sums() const; // column with the sum of every row
+    virtual Base_Matrix column_sums() const; // row with the sum of every column
+    virtual Base_Matrix row_means() const; // column with the mean of every row
+    virtual Base_Matrix column_means() const; // row with the mean of every column
+    virtual Base_Matrix row_norms() const; // column with the euclidean norm of every row
+    virtual Base_Matrix column_norms() const; // row with the euclidean norm of every column
+    virtual std::vector<size_t> row_argmin() const; // column index of the first smallest value of every row
+    virtual std::vector<size_t> row_argmax() const; // column index of the first largest value of every row
+    virtual std::vector<size_t> column_argmin() const; // row index of the first smallest value of every column
+    virtual std::vector<size_t> column_argmax() const; // row index of the first largest value of every column
 };
 
 #endif // _BASE_MATRIX_H_
\ No newline at end of file
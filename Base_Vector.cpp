@@ -1,14 +1,20 @@
 #include "Base_Vector.h"
-#include <iomanip>
+#include "Instrumentation.h"
+#include "Matrix_Writer.h"
+#include "Numa.h"
+#include "Reduction.h"
+#include <cmath>
 
 // ========================================================================================================================================== constructors and destructor
-Base_Vector::Base_Vector(size_t length, data_type init_value) : values{nullptr}, length{length} { // default constructor
+Base_Vector::Base_Vector(size_t length, data_type init_value) : values{nullptr}, length{length}, owns_values{true} { // default constructor
+    MATRICES_RECORD(Vector_Allocate, 0, length * sizeof(data_type));
     if(length == 0){
         std::cerr << "\nBase_Vector must be at least of length 1... \n";
         throw Base_Vector();
     }
     
     values = new data_type[length];
+    Numa::place(values, length * sizeof(data_type)); // before the first touch
     
     for(size_t i{} ; i < length ; i++)
         values[i] = init_value;
@@ -19,18 +25,36 @@ Base_Vector::Base_Vector(std::initializer_list<data_type> init_list) : Base_Vect
         values[i] = *(init_list.begin() + i);
 }
 
-Base_Vector::Base_Vector(const Base_Vector &source) : values{nullptr}, length{source.length}{ // copy constructor
+Base_Vector::Base_Vector(const Base_Vector &source) : values{nullptr}, length{source.length}, owns_values{true}{ // copy constructor
+    MATRICES_RECORD(Vector_Copy, 0, length * sizeof(data_type));
     values = new data_type[length];
+    Numa::place(values, length * sizeof(data_type)); // before the first touch
     for(size_t i{} ; i < length ; i++)
         values[i] = source.values[i];
 }
 
-Base_Vector::Base_Vector(Base_Vector &&source) : values{source.values}, length{source.length} { // move constructor
+Base_Vector::Base_Vector(Base_Vector &&source) noexcept : values{source.values}, length{source.length}, owns_values{source.owns_values} { // move constructor
+    MATRICES_RECORD(Vector_Move, 0, 0);
     source.values = nullptr;
+    source.owns_values = true;
 }
 
 Base_Vector::~Base_Vector(){ // destructor
-    delete[] values;
+    if(owns_values)
+        delete[] values;
+}
+
+Base_Vector Base_Vector::view(data_type* values, size_t length){ // non owning Base_Vector over existing memory
+    if(values == nullptr || length == 0){
+        std::cerr << "\nBase_Vector view needs valid memory of length at least 1... \n";
+        throw Base_Vector();
+    }
+    Base_Vector view;
+    delete[] view.values;
+    view.values = values;
+    view.length = length;
+    view.owns_values = false;
+    return view;
 }
 
 // ========================================================================================================================================== values insertion methods
@@ -39,15 +63,18 @@ void Base_Vector::insert_value(data_type value, size_t pos){ // insert value
         std::cerr << "\nInvalid position during value insertion... \n";
         throw Base_Vector();
     }
-    Base_Vector temp(*this); // hold current values
-    delete[] values;
-    values = new data_type[++length]; // increase length by 1
-    for(size_t i{}, j{} ; i < length ; i++){
+    data_type* inserted = new data_type[length + 1]; // increase length by 1
+    for(size_t i{}, j{} ; i < length + 1 ; i++){
         if(i == pos)
-            values[i] = value;
+            inserted[i] = value;
         else
-            values[i] = temp.values[j++];
+            inserted[i] = values[j++];
     }
+    if(owns_values)
+        delete[] values;
+    owns_values = true;
+    values = inserted;
+    length++;
 }
 
 void Base_Vector::delete_value(size_t pos){ // delete value
@@ -55,22 +82,22 @@ void Base_Vector::delete_value(size_t pos){ // delete value
         std::cerr << "\nInvalid position during value deletion... \n";
         throw Base_Vector();
     }
-    Base_Vector temp(*this); // hold current values
-    delete[] values;
-    values = new data_type[--length]; // decrease length by 1
-    for(size_t i{}, j{} ; i < length ; j++){
+    data_type* remaining = new data_type[length - 1]; // decrease length by 1
+    for(size_t i{}, j{} ; j < length ; j++){
         if(j != pos)
-            values[i++] = temp.values[j];
+            remaining[i++] = values[j];
     }
+    if(owns_values)
+        delete[] values;
+    owns_values = true;
+    values = remaining;
+    length--;
 }
 
 // ========================================================================================================================================== display and insertion operator
 std::ostream &operator<<(std::ostream &os, const Base_Vector &base_vector){ // stream insertion operator (friend function)
-    os << std::setprecision(3) << std::fixed;
-    for(size_t i{} ; i < base_vector.length ; i++){
-        os << ((base_vector.values[i] < 0) ? "" : " ");
-        os << base_vector.values[i] << " ";
-    }
+    Matrix_Writer writer(os);
+    writer.write(base_vector);
     return os;
 }
 
@@ -78,29 +105,52 @@ void Base_Vector::display() const{ // display method
     std::cout << (*this);
 }
 
+void Base_Vector::display(const Output_Format &format) const{ // display method with the given precision, delimiter and summarization
+    Matrix_Writer writer(std::cout, format);
+    writer.write(*this);
+}
+
 // ========================================================================================================================================== operators
 Base_Vector &Base_Vector::operator=(const Base_Vector &source){ // copy assignment
+    MATRICES_RECORD(Vector_Copy, 0, source.length * sizeof(data_type));
     if(&source == this)
         return *this;
-    delete[] values;
-    length = source.length;
-    values = new data_type[length];
+    if(!owns_values || length != source.length || values == nullptr){ // the existing buffer is reused when possible
+        data_type* copied = new data_type[source.length];
+        if(owns_values)
+            delete[] values;
+        owns_values = true;
+        values = copied;
+        length = source.length;
+    }
     for(size_t i{} ; i < length ; i++)
         values[i] = source.values[i];
     return *this;
 }
 
-Base_Vector &Base_Vector::operator=(Base_Vector &&source){ // move assignment
+Base_Vector &Base_Vector::operator=(Base_Vector &&source) noexcept{ // move assignment
+    MATRICES_RECORD(Vector_Move, 0, 0);
     if(this == &source)
         return *this;
-    delete[] values;
+    if(owns_values)
+        delete[] values;
     length = source.length;
     values = source.values;
+    owns_values = source.owns_values;
     source.values = nullptr;
+    source.owns_values = true;
     return *this;
 }
 
-data_type &Base_Vector::operator[](size_t i) const{ // subscript operator
+const data_type &Base_Vector::operator[](size_t i) const{ // subscript operator
+    if(i > length){
+        std::cerr << "\nIndex out of bounds... \n";
+        throw Base_Vector();
+    }
+    return values[i];
+}
+
+data_type &Base_Vector::operator[](size_t i){ // subscript operator
     if(i > length){
         std::cerr << "\nIndex out of bounds... \n";
         throw Base_Vector();
@@ -155,6 +205,15 @@ void Base_Vector::operator-=(const Base_Vector &base_vector){ // -= base_vector
         values[i] -= base_vector[i];
 }
 
+void Base_Vector::add_scaled(const Base_Vector &base_vector, data_type k){ // += k * base_vector, without a temporary Base_Vector
+    if(length != base_vector.length){
+        std::cerr << "\nCannot add Base_Vectors of different sizes... \n";
+        throw Base_Vector();
+    }
+    for(size_t i{} ; i < length ; i++)
+        values[i] += k * base_vector.values[i];
+}
+
 Base_Vector Base_Vector::operator-(data_type k) const{ // - double
     Base_Vector difference(*this);
     difference -= k;
@@ -207,4 +266,60 @@ Base_Vector Base_Vector::element_wise_product(const Base_Vector &left_vector, co
     for(size_t i{} ; i < left_vector.length ; i++)
         product[i] *= right_vector[i];
     return product;
+}
+
+// ========================================================================================================================================== reductions
+data_type Base_Vector::sum() const{ // pairwise sum, the same for any thread count
+    MATRICES_RECORD(Reduce, length, length * sizeof(data_type));
+    return Reduction::sum(values, length);
+}
+
+data_type Base_Vector::mean() const{ // arithmetic mean
+    if(length == 0){
+        std::cerr << "\nMean of an empty vector is not defined... \n";
+        throw Base_Vector();
+    }
+    return sum() / length;
+}
+
+data_type Base_Vector::min() const{ // smallest value
+    return values[argmin()];
+}
+
+data_type Base_Vector::max() const{ // largest value
+    return values[argmax()];
+}
+
+size_t Base_Vector::argmin() const{ // index of the first smallest value
+    MATRICES_RECORD(Reduce, length, length * sizeof(data_type));
+    return Reduction::index_of_min(values, length);
+}
+
+size_t Base_Vector::argmax() const{ // index of the first largest value
+    MATRICES_RECORD(Reduce, length, length * sizeof(data_type));
+    return Reduction::index_of_max(values, length);
+}
+
+data_type Base_Vector::norm() const{ // euclidean norm
+    MATRICES_RECORD(Reduce, 2 * length, length * sizeof(data_type));
+    return Reduction::euclidean_norm(values, length);
+}
+
+data_type Base_Vector::norm_1() const{ // sum of the absolute values
+    MATRICES_RECORD(Reduce, length, length * sizeof(data_type));
+    return Reduction::sum_of_absolutes(values, length);
+}
+
+data_type Base_Vector::norm_inf() const{ // largest absolute value
+    MATRICES_RECORD(Reduce, length, length * sizeof(data_type));
+    return (length == 0) ? 0 : std::fabs(values[Reduction::index_of_max_absolute(values, length)]);
+}
+
+data_type Base_Vector::dot(const Base_Vector &left_vector, const Base_Vector &right_vector){ // dot product (static member function)
+    MATRICES_RECORD(Reduce, 2 * left_vector.length, 2 * left_vector.length * sizeof(data_type));
+    if(left_vector.length != right_vector.length){
+        std::cerr << "\nDot product possible only for vectors of the same size... \n";
+        throw Base_Vector();
+    }
+    return Reduction::dot(left_vector.values, right_vector.values, left_vector.length);
 }
\ No newline at end of file
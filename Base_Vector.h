@@ -8,22 +8,30 @@
 
 typedef double data_type;
 
+struct Output_Format;
+
 class Base_Vector
 {
 protected:
     data_type* values;
     size_t length;
+    bool owns_values; // false for views of memory owned by someone else (for example a memory mapped file)
     
 public:
 // ========================================================================================================================================== constructors and destructor
     Base_Vector(size_t length = 1, data_type init_value = 0); // default constructor
     Base_Vector(std::initializer_list<data_type> init_list); // initailizer list constructor
     Base_Vector(const Base_Vector &source); // copy constructor
-    Base_Vector(Base_Vector &&source); // move constructor
+    Base_Vector(Base_Vector &&source) noexcept; // move constructor
     ~Base_Vector(); // destructor
     
+    static Base_Vector view(data_type* values, size_t length); // non owning Base_Vector over existing memory, assigning to it makes an owning copy
+    
 // ========================================================================================================================================== getters and setters
     size_t get_length() const { return length; } // get length
+    const data_type* data() const { return values; } // pointer to the contiguous values, no bounds checking
+    data_type* data() { return values; } // pointer to the contiguous values, no bounds checking
+    bool is_view() const { return !owns_values; } // true if the values are not owned by this Base_Vector
     
 // ========================================================================================================================================== values insertion methods
     void insert_value(data_type value, size_t pos); // insert value
@@ -32,12 +40,14 @@ public:
 // ========================================================================================================================================== display method and insertion operator
     friend std::ostream &operator<<(std::ostream &os, const Base_Vector &base_vector); // stream insertion operator (friend function)
     void display() const; // display method
+    void display(const Output_Format &format) const; // display method with the given precision, delimiter and summarization
 
 // ========================================================================================================================================== operators
     Base_Vector &operator=(const Base_Vector &source); // copy assignment
-    Base_Vector &operator=(Base_Vector &&source); // move assignment
+    Base_Vector &operator=(Base_Vector &&source) noexcept; // move assignment
     
-    data_type &operator[](size_t i) const; // subscript operator
+    const data_type &operator[](size_t i) const; // subscript operator
+    data_type &operator[](size_t i); // subscript operator
     Base_Vector operator-() const; // minus operator
 
     void operator+=(data_type k); // += double
@@ -47,6 +57,7 @@ public:
     
     void operator-=(data_type k); // -= double
     void operator-=(const Base_Vector &base_vector); // -= base_vector
+    void add_scaled(const Base_Vector &base_vector, data_type k); // += k * base_vector, without a temporary Base_Vector
     Base_Vector operator-(data_type k) const; // - double
     Base_Vector operator-(const Base_Vector &base_vector) const; // - base_vector
     
@@ -59,6 +70,18 @@ public:
     
 // ========================================================================================================================================== other mathematical operations
     static Base_Vector element_wise_product(const Base_Vector &left_vector, const Base_Vector &right_vector); // hadamard product, or element wise product (static function)
+    
+// ========================================================================================================================================== reductions
+    data_type sum() const; // pairwise sum, the same for any thread count
+    data_type mean() const; // arithmetic mean
+    data_type min() const; // smallest value
+    data_type max() const; // largest value
+    size_t argmin() const; // index of the first smallest value
+    size_t argmax() const; // index of the first largest value
+    data_type norm() const; // euclidean norm
+    data_type norm_1() const; // sum of the absolute values
+    data_type norm_inf() const; // largest absolute value
+    static data_type dot(const Base_Vector &left_vector, const Base_Vector &right_vector); // dot product (static function)
 };
 
 #endif // _BASE_VECTOR_H_
@@ -0,0 +1,63 @@
+#include "Executor.h"
+#include "Numa.h"
+#include "Parallel.h"
+
+// ========================================================================================================================================== constructors and destructor
+Executor::Executor(size_t thread_count) : stopping{false} { // 0 uses Parallel::get_thread_count()
+    if(thread_count == 0)
+        thread_count = Parallel::get_thread_count();
+    workers.reserve(thread_count);
+    bool pinned = Numa::is_pinning();
+    for(size_t t{} ; t < thread_count ; t++)
+        workers.emplace_back([this, t, thread_count, pinned](){
+            if(pinned)
+                Numa::pin_thread(t, thread_count);
+            work();
+        });
+}
+
+Executor::~Executor(){ // runs the jobs still queued, then joins the workers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for(auto &worker : workers)
+        worker.join();
+}
+
+Executor &Executor::shared(){ // executor of the library, created on first use (static function)
+    static Executor executor;
+    return executor;
+}
+
+// ========================================================================================================================================== getters
+size_t Executor::get_queued(){ // jobs waiting for a worker
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+// ========================================================================================================================================== submission
+void Executor::post(std::function<void()> job){ // fire and forget, an exception thrown by the job terminates the program
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    available.notify_one();
+}
+
+void Executor::work(){ // loop of a worker thread
+    Parallel::set_serial_thread(true);
+    while(true){
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this](){ return stopping || !jobs.empty(); });
+            if(jobs.empty())
+                return; // stopping and nothing left
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef _EXECUTOR_H_
+#define _EXECUTOR_H_
+
+// Executor is a persistent pool of worker threads running submitted jobs in the order of submission
+// submit returns a std::future of the result, an exception thrown by the job is rethrown by future.get()
+// the workers are serial threads (see Parallel.h), the loops of the operations they run stay on them, so n independent operations keep n cores busy
+// with Numa pinning enabled at construction, worker t runs on the core Numa::cpu_for(t, thread_count)
+// a single big operation is faster on the calling thread (its loops use all the cores), the executor pays off for several independent operations
+// a job must not wait for the future of another job of the same executor, with every worker waiting nobody would run it (use Task_Graph instead)
+// the operands are captured by the caller: captured by reference they have to outlive the future, captured by value they are copied
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Executor{
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void work(); // loop of a worker thread
+
+public:
+// ========================================================================================================================================== constructors and destructor
+    explicit Executor(size_t thread_count = 0); // 0 uses Parallel::get_thread_count()
+    Executor(const Executor&) = delete;
+    Executor &operator=(const Executor&) = delete;
+    ~Executor(); // runs the jobs still queued, then joins the workers
+
+    static Executor &shared(); // executor of the library, created on first use (static function)
+
+// ========================================================================================================================================== getters
+    size_t get_thread_count() const { return workers.size(); }
+    size_t get_queued(); // jobs waiting for a worker
+
+// ========================================================================================================================================== submission
+    void post(std::function<void()> job); // fire and forget, an exception thrown by the job terminates the program
+    template<typename Function>
+    auto submit(Function function) -> std::future<decltype(function())>; // runs function() on a worker
+};
+
+template<typename Function>
+auto Executor::submit(Function function) -> std::future<decltype(function())>{ // runs function() on a worker
+    typedef decltype(function()) Result;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+    std::future<Result> future = task->get_future();
+    post([task](){ (*task)(); });
+    return future;
+}
+
+#endif // _EXECUTOR_H_
@@ -0,0 +1,398 @@
+#include "Factorization.h"
+#include "Parallel.h"
+#include "Reduction.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+static const size_t values_per_chunk{1 << 15}; // smallest amount of work worth a separate thread
+
+static std::vector<data_type> values_of(const Base_Matrix &vector, size_t n){ // values of a row or column vector of length n
+    if(vector.get_rows() * vector.get_columns() != n || (vector.get_rows() != 1 && vector.get_columns() != 1)){
+        std::cerr << "\nVector length does not match the size of the matrix... \n";
+        throw Matrix();
+    }
+    std::vector<data_type> values(n);
+    for(size_t i{} ; i < n ; i++)
+        values[i] = (vector.get_rows() == 1) ? vector[0].data()[i] : vector[i].data()[0];
+    return values;
+}
+
+static Vector vector_like(const Base_Matrix &shape, const std::vector<data_type> &values){ // values in a Vector of the orientation of shape
+    Vector result(shape.get_columns(), shape.get_rows(), 0);
+    for(size_t i{} ; i < values.size() ; i++){
+        if(shape.get_rows() == 1)
+            result[0].data()[i] = values[i];
+        else
+            result[i].data()[0] = values[i];
+    }
+    return result;
+}
+
+static Base_Vector to_base_vector(const std::vector<data_type> &values){
+    Base_Vector result(values.size());
+    std::memcpy(result.data(), values.data(), values.size() * sizeof(data_type));
+    return result;
+}
+
+static void validate_square(const Base_Matrix &matrix){
+    if(matrix.get_rows() != matrix.get_columns()){
+        std::cerr << "\nOnly square matrices can be factorized... \n";
+        throw Matrix();
+    }
+}
+
+static void solve_transposed_upper(const Matrix &R, std::vector<data_type> &z){ // z = R^-T * z, by rows of R
+    size_t n = R.get_rows();
+    for(size_t i{} ; i < n ; i++){
+        const data_type* row = R[i].data();
+        z[i] /= row[i];
+        for(size_t j{i + 1} ; j < n ; j++)
+            z[j] -= row[j] * z[i];
+    }
+}
+
+static void solve_upper(const Matrix &U, std::vector<data_type> &z){ // z = U^-1 * z
+    size_t n = U.get_rows();
+    for(size_t i{n} ; i-- > 0 ; ){
+        const data_type* row = U[i].data();
+        data_type sum = z[i];
+        for(size_t j{i + 1} ; j < n ; j++)
+            sum -= row[j] * z[j];
+        z[i] = sum / row[i];
+    }
+}
+
+static void solve_unit_lower(const Matrix &L, std::vector<data_type> &z){ // z = L^-1 * z, L has an implicit unit diagonal
+    size_t n = L.get_rows();
+    for(size_t i{} ; i < n ; i++){
+        const data_type* row = L[i].data();
+        data_type sum = z[i];
+        for(size_t j{} ; j < i ; j++)
+            sum -= row[j] * z[j];
+        z[i] = sum;
+    }
+}
+
+// ========================================================================================================================================== Cholesky_Factorization
+Cholesky_Factorization::Cholesky_Factorization(const Matrix &matrix) : R(matrix){ // the matrix has to be symmetric positive definite, only its upper triangle is read
+    validate_square(R);
+    Base_Vector* rows_of_R = R.get_ptr();
+    size_t n = R.get_rows();
+    for(size_t k{} ; k < n ; k++){
+        data_type* row_k = R[k].data();
+        std::fill(row_k, row_k + k, 0); // the lower triangle is not part of the factor
+        if(!(row_k[k] > 0)){
+            std::cerr << "\nCholesky factorization needs a symmetric positive definite matrix... \n";
+            throw Matrix();
+        }
+        data_type pivot = std::sqrt(row_k[k]);
+        row_k[k] = pivot;
+        for(size_t j{k + 1} ; j < n ; j++)
+            row_k[j] /= pivot;
+        Parallel::for_range(k + 1, n, values_per_chunk / (n - k) + 1, [&](size_t first_row, size_t last_row){ // trailing upper triangle -= row_k^T * row_k
+            for(size_t i{first_row} ; i < last_row ; i++){
+                data_type* row_i = rows_of_R[i].data();
+                data_type factor = row_k[i];
+                for(size_t j{i} ; j < n ; j++)
+                    row_i[j] -= factor * row_k[j];
+            }
+        });
+    }
+}
+
+void Cholesky_Factorization::rotate_in(size_t first, std::vector<data_type> &x){ // R^T * R += x * x^T for the trailing block starting at first
+    size_t n = R.get_rows();
+    for(size_t k{first} ; k < n ; k++){
+        data_type* row = R[k].data();
+        data_type diagonal = std::hypot(row[k], x[k]);
+        data_type c = diagonal / row[k];
+        data_type s = x[k] / row[k];
+        row[k] = diagonal;
+        for(size_t j{k + 1} ; j < n ; j++){
+            row[j] = (row[j] + s * x[j]) / c;
+            x[j] = c * x[j] - s * row[j];
+        }
+    }
+}
+
+void Cholesky_Factorization::update(const Vector &x){ // A becomes A + x * x^T
+    std::vector<data_type> values = values_of(x, get_size());
+    rotate_in(0, values);
+}
+
+void Cholesky_Factorization::downdate(const Vector &x){ // A becomes A - x * x^T, the factorization stays unchanged if the result would not be positive definite
+    size_t n = get_size();
+    std::vector<data_type> values = values_of(x, n);
+    std::vector<data_type> p(values);
+    solve_transposed_upper(R, p); // A - x * x^T is positive definite exactly when |R^-T * x| < 1
+    if(!(Reduction::dot(p.data(), p.data(), n, false) < 1)){
+        std::cerr << "\nDowndated matrix would not be positive definite... \n";
+        throw Matrix();
+    }
+    for(size_t k{} ; k < n ; k++){
+        data_type* row = R[k].data();
+        data_type squared = (row[k] - values[k]) * (row[k] + values[k]);
+        if(!(squared > 0)){ // only possible through rounding for nearly singular results
+            std::cerr << "\nDowndated matrix is numerically singular... \n";
+            throw Matrix();
+        }
+        data_type diagonal = std::sqrt(squared);
+        data_type c = diagonal / row[k];
+        data_type s = values[k] / row[k];
+        row[k] = diagonal;
+        for(size_t j{k + 1} ; j < n ; j++){
+            row[j] = (row[j] - s * values[j]) / c;
+            values[j] = c * values[j] - s * row[j];
+        }
+    }
+}
+
+void Cholesky_Factorization::append(const Vector &column, data_type diagonal){ // A becomes [[A, column], [column^T, diagonal]]
+    size_t n = get_size();
+    std::vector<data_type> r = values_of(column, n);
+    solve_transposed_upper(R, r); // new column of R: R^T * r = column
+    data_type squared = diagonal - Reduction::dot(r.data(), r.data(), n, false);
+    if(!(squared > 0)){
+        std::cerr << "\nExtended matrix would not be positive definite... \n";
+        throw Matrix();
+    }
+    Base_Vector last_row(n + 1, 0);
+    last_row[n] = std::sqrt(squared);
+    R.insert_column(to_base_vector(r), n);
+    R.append_row(std::move(last_row));
+}
+
+void Cholesky_Factorization::remove(size_t pos){ // removes the row and the column pos of A
+    size_t n = get_size();
+    if(pos >= n || n == 1){
+        std::cerr << "\nInvalid position of the removed row and column... \n";
+        throw Matrix();
+    }
+    std::vector<data_type> x(n - 1, 0); // the part of the row pos right of the diagonal is rotated into the trailing block
+    std::copy(R[pos].data() + pos + 1, R[pos].data() + n, x.begin() + pos);
+    R.delete_row(pos);
+    R.delete_column(pos);
+    rotate_in(pos, x);
+}
+
+Vector Cholesky_Factorization::solve(const Vector &b) const{ // A^-1 * b
+    std::vector<data_type> z = values_of(b, get_size());
+    solve_transposed_upper(R, z);
+    solve_upper(R, z);
+    return vector_like(b, z);
+}
+
+data_type Cholesky_Factorization::determinant() const{
+    data_type det{1};
+    for(size_t k{} ; k < get_size() ; k++)
+        det *= R[k][k] * R[k][k];
+    return det;
+}
+
+// ========================================================================================================================================== LU_Factorization
+LU_Factorization::LU_Factorization(const Matrix &matrix) : factors(matrix), permutation(matrix.get_rows()), permutation_sign{1}{ // partial pivoting, the matrix has to be square and non singular
+    validate_square(factors);
+    Base_Vector* rows_of_factors = factors.get_ptr();
+    size_t n = factors.get_rows();
+    for(size_t i{} ; i < n ; i++)
+        permutation[i] = i;
+    for(size_t k{} ; k < n ; k++){
+        size_t pivot_row{k};
+        for(size_t i{k + 1} ; i < n ; i++)
+            if(std::fabs(factors[i].data()[k]) > std::fabs(factors[pivot_row].data()[k]))
+                pivot_row = i;
+        if(factors[pivot_row].data()[k] == 0){
+            std::cerr << "\nLU factorization of a singular matrix... \n";
+            throw Matrix();
+        }
+        if(pivot_row != k){
+            std::swap(factors[k], factors[pivot_row]); // swaps only the pointers
+            std::swap(permutation[k], permutation[pivot_row]);
+            permutation_sign = -permutation_sign;
+        }
+        const data_type* row_k = factors[k].data();
+        Parallel::for_range(k + 1, n, values_per_chunk / (n - k) + 1, [&](size_t first_row, size_t last_row){
+            for(size_t i{first_row} ; i < last_row ; i++){
+                data_type* row_i = rows_of_factors[i].data();
+                data_type factor = row_i[k] / row_k[k];
+                row_i[k] = factor;
+                for(size_t j{k + 1} ; j < n ; j++)
+                    row_i[j] -= factor * row_k[j];
+            }
+        });
+    }
+}
+
+Matrix LU_Factorization::get_L() const{ // unit lower triangular factor
+    size_t n = get_size();
+    Matrix L(Matrix::identity_matrix(n));
+    for(size_t i{} ; i < n ; i++)
+        std::copy(factors[i].data(), factors[i].data() + i, L[i].data());
+    return L;
+}
+
+Matrix LU_Factorization::get_U() const{ // upper triangular factor
+    size_t n = get_size();
+    Matrix U(n, n, 0);
+    for(size_t i{} ; i < n ; i++)
+        std::copy(factors[i].data() + i, factors[i].data() + n, U[i].data() + i);
+    return U;
+}
+
+void LU_Factorization::update(const Vector &x, const Vector &y){ // A becomes A + x * y^T, throws if a pivot becomes zero (the factorization has to be computed again then)
+    size_t n = get_size();
+    std::vector<data_type> x_values = values_of(x, n);
+    std::vector<data_type> y_values = values_of(y, n);
+    std::vector<data_type> permuted(n); // P * A + (P * x) * y^T = L * U + (P * x) * y^T
+    for(size_t i{} ; i < n ; i++)
+        permuted[i] = x_values[permutation[i]];
+
+    for(size_t j{} ; j < n ; j++){ // Bennett's algorithm, the trailing factors absorb the rank-1 term one row and column at a time
+        data_type* row_j = factors[j].data();
+        data_type t = permuted[j];
+        data_type s = y_values[j];
+        data_type old_pivot = row_j[j];
+        data_type pivot = old_pivot + t * s;
+        if(pivot == 0){
+            std::cerr << "\nZero pivot in the LU update, the factorization has to be computed again... \n";
+            throw Matrix();
+        }
+        row_j[j] = pivot;
+        for(size_t k{j + 1} ; k < n ; k++)
+            row_j[k] += t * y_values[k];
+        for(size_t i{j + 1} ; i < n ; i++){
+            data_type* row_i = factors[i].data();
+            data_type old_l = row_i[j];
+            row_i[j] = (old_l * old_pivot + permuted[i] * s) / pivot;
+            permuted[i] -= t * old_l;
+        }
+        data_type coefficient = s / pivot;
+        for(size_t k{j + 1} ; k < n ; k++)
+            y_values[k] -= coefficient * row_j[k];
+    }
+}
+
+void LU_Factorization::append(const Vector &column, const Vector &row, data_type corner){ // A becomes [[A, column], [row^T, corner]]
+    size_t n = get_size();
+    std::vector<data_type> column_values = values_of(column, n);
+    std::vector<data_type> u(n); // new column of U: L * u = P * column
+    for(size_t i{} ; i < n ; i++)
+        u[i] = column_values[permutation[i]];
+    solve_unit_lower(factors, u);
+    std::vector<data_type> l = values_of(row, n); // new row of L: U^T * l = row
+    for(size_t k{} ; k < n ; k++){
+        const data_type* row_k = factors[k].data();
+        l[k] /= row_k[k];
+        for(size_t j{k + 1} ; j < n ; j++)
+            l[j] -= row_k[j] * l[k];
+    }
+    data_type pivot = corner - Reduction::dot(l.data(), u.data(), n, false);
+    if(pivot == 0){
+        std::cerr << "\nExtended matrix is singular without pivoting... \n";
+        throw Matrix();
+    }
+    l.push_back(pivot);
+    factors.insert_column(to_base_vector(u), n);
+    factors.append_row(to_base_vector(l));
+    permutation.push_back(n);
+}
+
+Vector LU_Factorization::solve(const Vector &b) const{ // A^-1 * b
+    size_t n = get_size();
+    std::vector<data_type> b_values = values_of(b, n);
+    std::vector<data_type> z(n);
+    for(size_t i{} ; i < n ; i++)
+        z[i] = b_values[permutation[i]];
+    solve_unit_lower(factors, z);
+    solve_upper(factors, z);
+    return vector_like(b, z);
+}
+
+data_type LU_Factorization::determinant() const{
+    data_type det = permutation_sign;
+    for(size_t k{} ; k < get_size() ; k++)
+        det *= factors[k][k];
+    return det;
+}
+
+// ========================================================================================================================================== Inverse_Update
+void Inverse_Update::sherman_morrison(Matrix &inverse, const Vector &u, const Vector &v){ // inverse of A becomes the inverse of A + u * v^T (static function)
+    validate_square(inverse);
+    size_t n = inverse.get_rows();
+    std::vector<data_type> u_values = values_of(u, n);
+    std::vector<data_type> v_values = values_of(v, n);
+    std::vector<data_type> a(n); // A^-1 * u
+    std::vector<data_type> b(n, 0); // v^T * A^-1
+    for(size_t i{} ; i < n ; i++){
+        const data_type* row = inverse[i].data();
+        a[i] = Reduction::dot(row, u_values.data(), n, false);
+        for(size_t j{} ; j < n ; j++)
+            b[j] += v_values[i] * row[j];
+    }
+    data_type denominator = 1 + Reduction::dot(v_values.data(), a.data(), n, false);
+    if(denominator == 0){
+        std::cerr << "\nUpdated matrix is singular... \n";
+        throw Inverse_Update();
+    }
+    Base_Vector* rows_of_inverse = inverse.get_ptr();
+    Parallel::for_range(0, n, values_per_chunk / n + 1, [&](size_t first_row, size_t last_row){
+        for(size_t i{first_row} ; i < last_row ; i++){
+            data_type* row = rows_of_inverse[i].data();
+            data_type factor = a[i] / denominator;
+            for(size_t j{} ; j < n ; j++)
+                row[j] -= factor * b[j];
+        }
+    });
+}
+
+void Inverse_Update::woodbury(Matrix &inverse, const Matrix &U, const Matrix &V){ // inverse of A becomes the inverse of A + U * V^T, U and V are n x k (static function)
+    validate_square(inverse);
+    size_t n = inverse.get_rows();
+    if(U.get_rows() != n || V.get_rows() != n || U.get_columns() != V.get_columns()){
+        std::cerr << "\nWoodbury update needs U and V of the same n x k size... \n";
+        throw Inverse_Update();
+    }
+    size_t k = U.get_columns();
+    Matrix V_transponed(V.transpone());
+    Matrix inverse_U(inverse * U); // n x k
+    Matrix V_inverse(V_transponed * inverse); // k x n
+    Matrix capacitance(Matrix::identity_matrix(k) + V_transponed * inverse_U); // k x k, I + V^T * A^-1 * U, invert throws when the update is singular
+    inverse -= inverse_U * (capacitance.invert() * V_inverse);
+}
+
+void Inverse_Update::append(Matrix &inverse, const Vector &column, const Vector &row, data_type corner){ // inverse of A becomes the inverse of [[A, column], [row^T, corner]] (static function)
+    validate_square(inverse);
+    size_t n = inverse.get_rows();
+    std::vector<data_type> column_values = values_of(column, n);
+    std::vector<data_type> row_values = values_of(row, n);
+    std::vector<data_type> a(n); // A^-1 * column
+    std::vector<data_type> b(n, 0); // row^T * A^-1
+    for(size_t i{} ; i < n ; i++){
+        const data_type* inverse_row = inverse[i].data();
+        a[i] = Reduction::dot(inverse_row, column_values.data(), n, false);
+        for(size_t j{} ; j < n ; j++)
+            b[j] += row_values[i] * inverse_row[j];
+    }
+    data_type schur = corner - Reduction::dot(row_values.data(), a.data(), n, false); // Schur complement of A
+    if(schur == 0){
+        std::cerr << "\nExtended matrix is singular... \n";
+        throw Inverse_Update();
+    }
+
+    std::vector<data_type> new_column(n);
+    for(size_t i{} ; i < n ; i++){
+        data_type* inverse_row = inverse[i].data();
+        data_type factor = a[i] / schur;
+        for(size_t j{} ; j < n ; j++)
+            inverse_row[j] += factor * b[j];
+        new_column[i] = -factor;
+    }
+    std::vector<data_type> new_row(n + 1);
+    for(size_t j{} ; j < n ; j++)
+        new_row[j] = -b[j] / schur;
+    new_row[n] = 1 / schur;
+    inverse.insert_column(to_base_vector(new_column), n);
+    inverse.append_row(to_base_vector(new_row));
+}
@@ -0,0 +1,72 @@
+#ifndef _FACTORIZATION_H_
+#define _FACTORIZATION_H_
+
+// Cholesky_Factorization and LU_Factorization keep a factorization of a square matrix and update it when the matrix changes a little
+// a rank-1 change (A + x * y^T) or a new row and column costs O(n^2) instead of the O(n^3) of factorizing again
+// Cholesky_Factorization stores the upper triangular R with A = R^T * R, the updates use Givens-like rotations and are backward stable
+// LU_Factorization stores L and U of the row permuted matrix, P * A = L * U (partial pivoting), the rank-1 update is Bennett's algorithm
+// Bennett's algorithm does not pivot again, so it is only as stable as the pivots it meets, after many updates factorizing again is recommended
+// Inverse_Update applies the same kind of changes directly to an explicit inverse (Sherman-Morrison, Woodbury and the bordered inverse)
+// all vectors can be row or column vectors, the results of solve have the orientation of the right hand side
+
+#include <vector>
+#include "Matrix.h"
+#include "Vector.h"
+
+class Cholesky_Factorization{
+    Matrix R; // upper triangular, A = R^T * R
+
+    void rotate_in(size_t first, std::vector<data_type> &x); // R^T * R += x * x^T for the trailing block starting at first
+
+public:
+// ========================================================================================================================================== constructors
+    Cholesky_Factorization(const Matrix &matrix); // the matrix has to be symmetric positive definite, only its upper triangle is read
+
+// ========================================================================================================================================== getters
+    size_t get_size() const { return R.get_rows(); }
+    const Matrix &get_R() const { return R; } // upper triangular factor
+    Matrix get_L() const { return R.transpone(); } // lower triangular factor, A = L * L^T
+
+// ========================================================================================================================================== updates
+    void update(const Vector &x); // A becomes A + x * x^T
+    void downdate(const Vector &x); // A becomes A - x * x^T, the factorization stays unchanged if the result would not be positive definite
+    void append(const Vector &column, data_type diagonal); // A becomes [[A, column], [column^T, diagonal]]
+    void remove(size_t pos); // removes the row and the column pos of A
+
+// ========================================================================================================================================== solving
+    Vector solve(const Vector &b) const; // A^-1 * b
+    data_type determinant() const;
+};
+
+class LU_Factorization{
+    Matrix factors; // strictly lower part holds L (with an implicit unit diagonal), the rest holds U
+    std::vector<size_t> permutation; // row i of the factors corresponds to the row permutation[i] of A
+    int permutation_sign;
+
+public:
+// ========================================================================================================================================== constructors
+    LU_Factorization(const Matrix &matrix); // partial pivoting, the matrix has to be square and non singular
+
+// ========================================================================================================================================== getters
+    size_t get_size() const { return factors.get_rows(); }
+    Matrix get_L() const; // unit lower triangular factor
+    Matrix get_U() const; // upper triangular factor
+    const std::vector<size_t> &get_permutation() const { return permutation; }
+
+// ========================================================================================================================================== updates
+    void update(const Vector &x, const Vector &y); // A becomes A + x * y^T, throws if a pivot becomes zero (the factorization has to be computed again then)
+    void append(const Vector &column, const Vector &row, data_type corner); // A becomes [[A, column], [row^T, corner]]
+
+// ========================================================================================================================================== solving
+    Vector solve(const Vector &b) const; // A^-1 * b
+    data_type determinant() const;
+};
+
+class Inverse_Update{
+public:
+    static void sherman_morrison(Matrix &inverse, const Vector &u, const Vector &v); // inverse of A becomes the inverse of A + u * v^T (static function)
+    static void woodbury(Matrix &inverse, const Matrix &U, const Matrix &V); // inverse of A becomes the inverse of A + U * V^T, U and V are n x k (static function)
+    static void append(Matrix &inverse, const Vector &column, const Vector &row, data_type corner); // inverse of A becomes the inverse of [[A, column], [row^T, corner]] (static function)
+};
+
+#endif // _FACTORIZATION_H_
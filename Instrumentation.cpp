@@ -0,0 +1,192 @@
+#include "Instrumentation.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+struct Trace_Event{
+    Instrumentation::Operation operation;
+    uint64_t start; // nanoseconds
+    uint64_t duration; // nanoseconds
+};
+
+struct Thread_Record{ // counters of a single thread, only that thread writes them
+    std::array<std::array<std::atomic<uint64_t>, 4>, Instrumentation::operation_count> counters{};
+    std::mutex events_mutex; // taken only while tracing, so the snapshot does not read a vector that is growing
+    std::vector<Trace_Event> events;
+    uint64_t thread_id{};
+};
+
+struct Registry{ // all the living threads, plus everything that the finished threads recorded
+    std::mutex mutex;
+    std::vector<Thread_Record*> threads;
+    std::array<Instrumentation::Counters, Instrumentation::operation_count> retired{};
+    std::array<Instrumentation::Counters, Instrumentation::operation_count> baseline{}; // value of the counters at the last reset
+    std::vector<std::pair<uint64_t, Trace_Event>> retired_events;
+    uint64_t next_thread_id{1};
+    std::atomic<bool> tracing{false};
+};
+
+static Registry &registry(){
+    static Registry instance;
+    return instance;
+}
+
+struct Thread_Handle{ // registers the counters of the thread on its first use and folds them into the registry when the thread ends
+    Thread_Record* record;
+
+    Thread_Handle() : record{new Thread_Record}{
+        Registry &shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        record->thread_id = shared.next_thread_id++;
+        shared.threads.push_back(record);
+    }
+
+    ~Thread_Handle(){
+        Registry &shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for(size_t o{} ; o < Instrumentation::operation_count ; o++){
+            shared.retired[o].calls += record->counters[o][0].load(std::memory_order_relaxed);
+            shared.retired[o].flops += record->counters[o][1].load(std::memory_order_relaxed);
+            shared.retired[o].bytes += record->counters[o][2].load(std::memory_order_relaxed);
+            shared.retired[o].nanoseconds += record->counters[o][3].load(std::memory_order_relaxed);
+        }
+        for(const auto &event : record->events)
+            shared.retired_events.push_back({record->thread_id, event});
+        shared.threads.erase(std::find(shared.threads.begin(), shared.threads.end(), record));
+        delete record;
+    }
+};
+
+static Thread_Record* local_record() noexcept{
+    try{
+        thread_local Thread_Handle handle;
+        return handle.record;
+    }
+    catch(...){ // out of memory while registering, the call is not recorded
+        return nullptr;
+    }
+}
+
+static void add(std::atomic<uint64_t> &counter, uint64_t value) noexcept{ // single writer, so a plain load and store is enough
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// ========================================================================================================================================== recording
+void Instrumentation::record(Operation operation, uint64_t flops, uint64_t bytes) noexcept{ // one call of the operation
+    Thread_Record* record = local_record();
+    if(record == nullptr)
+        return;
+    add(record->counters[operation][0], 1);
+    add(record->counters[operation][1], flops);
+    add(record->counters[operation][2], bytes);
+}
+
+void Instrumentation::record_time(Operation operation, uint64_t start_nanoseconds, uint64_t nanoseconds) noexcept{ // time spent in one call
+    Thread_Record* record = local_record();
+    if(record == nullptr)
+        return;
+    add(record->counters[operation][3], nanoseconds);
+    if(registry().tracing.load(std::memory_order_relaxed)){
+        try{
+            std::lock_guard<std::mutex> lock(record->events_mutex);
+            record->events.push_back({operation, start_nanoseconds, nanoseconds});
+        }
+        catch(...){ // out of memory, the event is dropped
+        }
+    }
+}
+
+uint64_t Instrumentation::now() noexcept{ // monotonic time in nanoseconds
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ========================================================================================================================================== tracing
+void Instrumentation::set_tracing(bool enabled){ // timed scopes are also stored as trace events while enabled
+    registry().tracing.store(enabled);
+}
+
+bool Instrumentation::is_tracing(){
+    return registry().tracing.load();
+}
+
+// ========================================================================================================================================== snapshots and export
+const char* Instrumentation::operation_name(Operation operation){
+    static const char* names[operation_count]{
+        "vector_allocate", "vector_copy", "vector_move",
+        "matrix_copy", "matrix_move",
+        "element_wise", "multiply", "transpone",
+        "invert", "LU_decomposition", "determinant",
+        "random_fill", "save", "load", "reduce", "solve"
+    };
+    return (operation < operation_count) ? names[operation] : "unknown";
+}
+
+static std::array<Instrumentation::Counters, Instrumentation::operation_count> total_counters(Registry &shared){ // registry mutex has to be held
+    auto total = shared.retired;
+    for(Thread_Record* record : shared.threads){
+        for(size_t o{} ; o < Instrumentation::operation_count ; o++){
+            total[o].calls += record->counters[o][0].load(std::memory_order_relaxed);
+            total[o].flops += record->counters[o][1].load(std::memory_order_relaxed);
+            total[o].bytes += record->counters[o][2].load(std::memory_order_relaxed);
+            total[o].nanoseconds += record->counters[o][3].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+std::array<Instrumentation::Counters, Instrumentation::operation_count> Instrumentation::snapshot(){ // sum of the counters of all threads
+    Registry &shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto total = total_counters(shared);
+    for(size_t o{} ; o < operation_count ; o++){
+        total[o].calls -= shared.baseline[o].calls;
+        total[o].flops -= shared.baseline[o].flops;
+        total[o].bytes -= shared.baseline[o].bytes;
+        total[o].nanoseconds -= shared.baseline[o].nanoseconds;
+    }
+    return total;
+}
+
+void Instrumentation::reset(){ // zeroes the counters and drops the trace events
+    Registry &shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.baseline = total_counters(shared); // counters are never written by other threads than their owners, the baseline is subtracted instead
+    shared.retired_events.clear();
+    for(Thread_Record* record : shared.threads){
+        std::lock_guard<std::mutex> events_lock(record->events_mutex);
+        record->events.clear();
+    }
+}
+
+void Instrumentation::write_json(std::ostream &os){ // counters of every operation as a JSON object
+    auto counters = snapshot();
+    os << "{";
+    for(size_t o{} ; o < operation_count ; o++){
+        os << ((o == 0) ? "" : ",") << "\"" << operation_name(static_cast<Operation>(o)) << "\":{"
+           << "\"calls\":" << counters[o].calls << ",\"flops\":" << counters[o].flops
+           << ",\"bytes\":" << counters[o].bytes << ",\"nanoseconds\":" << counters[o].nanoseconds << "}";
+    }
+    os << "}\n";
+}
+
+void Instrumentation::write_chrome_trace(std::ostream &os){ // recorded trace events in the Chrome trace event format
+    Registry &shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    bool first{true};
+    auto write_event = [&os, &first](uint64_t thread_id, const Trace_Event &event){
+        os << (first ? "" : ",\n") << "{\"name\":\"" << operation_name(event.operation) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id
+           << ",\"ts\":" << event.start / 1000 << "." << (event.start % 1000) / 100 << ",\"dur\":" << event.duration / 1000 << "." << (event.duration % 1000) / 100 << "}";
+        first = false;
+    };
+    os << "{\"traceEvents\":[\n";
+    for(const auto &retired : shared.retired_events)
+        write_event(retired.first, retired.second);
+    for(Thread_Record* record : shared.threads){
+        std::lock_guard<std::mutex> events_lock(record->events_mutex);
+        for(const auto &event : record->events)
+            write_event(record->thread_id, event);
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
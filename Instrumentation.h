@@ -0,0 +1,68 @@
+#ifndef _INSTRUMENTATION_H_
+#define _INSTRUMENTATION_H_
+
+// Instrumentation counts calls, floating point operations, bytes and wall time of the hot operations of the library
+// the hooks in the library are the MATRICES_RECORD and MATRICES_TIMED_SCOPE macros, they compile to nothing unless MATRICES_INSTRUMENTATION is defined
+// every thread updates its own counters without locks, a snapshot sums the counters of all threads (including the threads that already finished)
+// scoped timings can additionally be recorded as events and exported in the Chrome trace format (chrome://tracing, Perfetto)
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+class Instrumentation{
+public:
+    enum Operation{
+        Vector_Allocate, Vector_Copy, Vector_Move,
+        Matrix_Copy, Matrix_Move,
+        Element_Wise, Multiply, Transpone,
+        Invert, LU_Decomposition, Determinant,
+        Random_Fill, Save, Load, Reduce, Solve,
+        operation_count
+    };
+
+    struct Counters{
+        uint64_t calls;
+        uint64_t flops;
+        uint64_t bytes;
+        uint64_t nanoseconds; // only for the operations with a timed scope
+    };
+
+// ========================================================================================================================================== recording
+    static void record(Operation operation, uint64_t flops = 0, uint64_t bytes = 0) noexcept; // one call of the operation
+    static void record_time(Operation operation, uint64_t start_nanoseconds, uint64_t nanoseconds) noexcept; // time spent in one call
+    static uint64_t now() noexcept; // monotonic time in nanoseconds
+
+// ========================================================================================================================================== tracing
+    static void set_tracing(bool enabled); // timed scopes are also stored as trace events while enabled
+    static bool is_tracing();
+
+// ========================================================================================================================================== snapshots and export
+    static const char* operation_name(Operation operation);
+    static std::array<Counters, operation_count> snapshot(); // sum of the counters of all threads
+    static void reset(); // zeroes the counters and drops the trace events
+    static void write_json(std::ostream &os); // counters of every operation as a JSON object
+    static void write_chrome_trace(std::ostream &os); // recorded trace events in the Chrome trace event format
+};
+
+class Scoped_Timer{ // measures the time between its construction and destruction
+    Instrumentation::Operation operation;
+    uint64_t start;
+
+public:
+    Scoped_Timer(Instrumentation::Operation operation) noexcept : operation{operation}, start{Instrumentation::now()} {}
+    Scoped_Timer(const Scoped_Timer &source) = delete;
+    Scoped_Timer &operator=(const Scoped_Timer &source) = delete;
+    ~Scoped_Timer() { Instrumentation::record_time(operation, start, Instrumentation::now() - start); }
+};
+
+#ifdef MATRICES_INSTRUMENTATION
+    #define MATRICES_RECORD(operation, flops, bytes) Instrumentation::record(Instrumentation::operation, (flops), (bytes))
+    #define MATRICES_TIMED_SCOPE(operation) Scoped_Timer matrices_scoped_timer(Instrumentation::operation)
+#else
+    #define MATRICES_RECORD(operation, flops, bytes) ((void)0)
+    #define MATRICES_TIMED_SCOPE(operation) ((void)0)
+#endif
+
+#endif // _INSTRUMENTATION_H_
@@ -0,0 +1,335 @@
+#include "Krylov_Solver.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "Reduction.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const size_t values_per_chunk{1 << 15}; // smallest amount of work worth a separate thread
+
+static size_t validate(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner){ // returns the size of the system, x becomes zeros if it is not a valid initial guess
+    size_t n = b.get_rows() * b.get_columns();
+    if(n != A.get_size()){
+        std::cerr << "\nLength of the right hand side does not match the size of the operator... \n";
+        throw Krylov_Solver();
+    }
+    if(preconditioner != nullptr && preconditioner->get_size() != n){
+        std::cerr << "\nSize of the preconditioner does not match the size of the operator... \n";
+        throw Krylov_Solver();
+    }
+    if(x.get_rows() * x.get_columns() != n)
+        x = Vector(b.get_columns(), b.get_rows(), 0);
+    return n;
+}
+
+static void load(const Base_Matrix &vector, Base_Vector &values){ // values of a row or column vector copied into a contiguous Base_Vector
+    if(vector.get_rows() == 1)
+        std::memcpy(values.data(), vector[0].data(), values.get_length() * sizeof(data_type));
+    else
+        for(size_t r{} ; r < values.get_length() ; r++)
+            values.data()[r] = vector[r].data()[0];
+}
+
+static void store(const Base_Vector &values, Base_Matrix &vector){ // contiguous values copied back into a row or column vector
+    if(vector.get_rows() == 1)
+        std::memcpy(vector[0].data(), values.data(), values.get_length() * sizeof(data_type));
+    else
+        for(size_t r{} ; r < values.get_length() ; r++)
+            vector[r].data()[0] = values.data()[r];
+}
+
+static void residual_of(const Linear_Operator &A, const Base_Vector &rhs, const Base_Vector &solution, Base_Vector &residual){ // residual = rhs - A * solution
+    A.apply(solution, residual);
+    data_type* r = residual.data();
+    const data_type* b = rhs.data();
+    for(size_t i{} ; i < residual.get_length() ; i++)
+        r[i] = b[i] - r[i];
+}
+
+static void precondition(const Preconditioner* preconditioner, const Base_Vector &residual, Base_Vector &result){ // result = M^-1 * residual, a copy without a preconditioner
+    if(preconditioner != nullptr)
+        preconditioner->apply(residual, result);
+    else
+        result = residual;
+}
+
+static data_type dot(const Base_Vector &left, const Base_Vector &right, Reduction_Workspace &workspace){ // dot product of two workspace vectors, without allocating
+    return Reduction::dot(left.data(), right.data(), left.get_length(), workspace);
+}
+
+static data_type norm(const Base_Vector &values, Reduction_Workspace &workspace){ // euclidean norm of a workspace vector, without allocating
+    return Reduction::euclidean_norm(values.data(), values.get_length(), workspace);
+}
+
+static void scale_and_add(Base_Vector &y, data_type k, const Base_Vector &x){ // y = k * y + x
+    data_type* out = y.data();
+    const data_type* in = x.data();
+    for(size_t i{} ; i < y.get_length() ; i++)
+        out[i] = k * out[i] + in[i];
+}
+
+// ========================================================================================================================================== Linear_Operator
+Linear_Operator::Linear_Operator(const Base_Matrix &matrix) : size{matrix.get_rows()}{ // keeps a reference, the matrix has to outlive the operator
+    if(matrix.get_rows() != matrix.get_columns()){
+        std::cerr << "\nLinear operator needs a square matrix... \n";
+        throw Base_Matrix();
+    }
+    product = [&matrix](const Base_Vector &input, Base_Vector &output){
+        size_t n = matrix.get_rows();
+        if(input.get_length() != n || output.get_length() != n || input.data() == output.data()){
+            std::cerr << "\nInvalid vectors of the matrix-vector product... \n";
+            throw Base_Matrix();
+        }
+        MATRICES_RECORD(Multiply, 2 * n * n, (n * n + 2 * n) * sizeof(data_type));
+        const data_type* in = input.data();
+        data_type* out = output.data();
+        Parallel::for_range(0, n, values_per_chunk / n + 1, [&](size_t first_row, size_t last_row){
+            static thread_local Reduction_Workspace workspace; // long rows are summed in blocks, the partials are kept by the thread
+            for(size_t r{first_row} ; r < last_row ; r++)
+                out[r] = Reduction::dot(matrix[r].data(), in, n, workspace, false);
+        });
+    };
+}
+
+Linear_Operator::Linear_Operator(const Sparse_Matrix &matrix) : size{matrix.get_rows()}{ // keeps a reference, the matrix has to outlive the operator
+    if(matrix.get_rows() != matrix.get_columns()){
+        std::cerr << "\nLinear operator needs a square matrix... \n";
+        throw Base_Matrix();
+    }
+    product = [&matrix](const Base_Vector &input, Base_Vector &output){ matrix.multiply(input, output); };
+}
+
+Linear_Operator::Linear_Operator(size_t size, std::function<void(const Base_Vector &input, Base_Vector &output)> product) : size{size}, product{std::move(product)}{ // matrix free operator
+    if(size < 1 || !this->product){
+        std::cerr << "\nLinear operator needs a size and a product function... \n";
+        throw Base_Matrix();
+    }
+}
+
+// ========================================================================================================================================== constructors
+Krylov_Solver::Krylov_Solver(data_type tolerance, size_t max_iterations, size_t restart) : tolerance{tolerance}, max_iterations{max_iterations}, restart{restart}{
+    if(tolerance < 0 || restart < 1){
+        std::cerr << "\nTolerance cannot be negative and restart has to be at least 1... \n";
+        throw Krylov_Solver();
+    }
+}
+
+void Krylov_Solver::prepare(size_t length, size_t count){ // makes sure the workspace holds count vectors of the given length
+    for(size_t i{} ; i < count && i < workspace.size() ; i++)
+        if(workspace[i].get_length() != length)
+            workspace[i] = Base_Vector(length);
+    while(workspace.size() < count)
+        workspace.emplace_back(length);
+}
+
+// ========================================================================================================================================== getters and setters
+void Krylov_Solver::set_tolerance(data_type tolerance){
+    if(tolerance < 0){
+        std::cerr << "\nTolerance cannot be negative... \n";
+        throw Krylov_Solver();
+    }
+    this->tolerance = tolerance;
+}
+
+void Krylov_Solver::set_restart(size_t restart){
+    if(restart < 1){
+        std::cerr << "\nRestart has to be at least 1... \n";
+        throw Krylov_Solver();
+    }
+    this->restart = restart;
+}
+
+// ========================================================================================================================================== solvers
+Solver_Result Krylov_Solver::conjugate_gradient(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner){ // symmetric positive definite A
+    MATRICES_TIMED_SCOPE(Solve);
+    MATRICES_RECORD(Solve, 0, 0);
+    size_t n = validate(A, b, x, preconditioner);
+    prepare(n, 6);
+    Base_Vector &rhs = workspace[0], &solution = workspace[1], &r = workspace[2], &z = workspace[3], &p = workspace[4], &Ap = workspace[5];
+    load(b, rhs);
+    load(x, solution);
+    data_type rhs_norm = norm(rhs, reduction_workspace);
+    if(rhs_norm == 0){ // the solution is zero
+        std::fill(solution.data(), solution.data() + n, 0);
+        store(solution, x);
+        return {true, 0, 0};
+    }
+
+    residual_of(A, rhs, solution, r);
+    data_type residual = norm(r, reduction_workspace) / rhs_norm;
+    size_t iteration{};
+    if(residual > tolerance){
+        precondition(preconditioner, r, z);
+        p = z;
+        data_type rz = dot(r, z, reduction_workspace);
+        while(iteration < max_iterations){
+            A.apply(p, Ap);
+            iteration++;
+            data_type pAp = dot(p, Ap, reduction_workspace);
+            if(!(pAp > 0)) // A (or the preconditioner) is not positive definite
+                break;
+            data_type alpha = rz / pAp;
+            solution.add_scaled(p, alpha);
+            r.add_scaled(Ap, -alpha);
+            residual = norm(r, reduction_workspace) / rhs_norm;
+            if(residual <= tolerance)
+                break;
+            precondition(preconditioner, r, z);
+            data_type rz_next = dot(r, z, reduction_workspace);
+            scale_and_add(p, rz_next / rz, z); // p = z + beta * p
+            rz = rz_next;
+        }
+    }
+    store(solution, x);
+    return {residual <= tolerance, iteration, residual};
+}
+
+Solver_Result Krylov_Solver::bicgstab(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner){ // stabilized bi-conjugate gradient
+    MATRICES_TIMED_SCOPE(Solve);
+    MATRICES_RECORD(Solve, 0, 0);
+    size_t n = validate(A, b, x, preconditioner);
+    prepare(n, 9);
+    Base_Vector &rhs = workspace[0], &solution = workspace[1], &r = workspace[2], &r_hat = workspace[3], &p = workspace[4];
+    Base_Vector &v = workspace[5], &p_hat = workspace[6], &s_hat = workspace[7], &t = workspace[8];
+    load(b, rhs);
+    load(x, solution);
+    data_type rhs_norm = norm(rhs, reduction_workspace);
+    if(rhs_norm == 0){ // the solution is zero
+        std::fill(solution.data(), solution.data() + n, 0);
+        store(solution, x);
+        return {true, 0, 0};
+    }
+
+    residual_of(A, rhs, solution, r);
+    data_type residual = norm(r, reduction_workspace) / rhs_norm;
+    r_hat = r;
+    std::fill(p.data(), p.data() + n, 0);
+    std::fill(v.data(), v.data() + n, 0);
+    data_type rho{1}, alpha{1}, omega{1};
+    size_t iteration{};
+    while(residual > tolerance && iteration < max_iterations){
+        iteration++;
+        data_type rho_next = dot(r_hat, r, reduction_workspace);
+        if(rho_next == 0) // breakdown, the shadow residual became orthogonal to the residual
+            break;
+        p.add_scaled(v, -omega); // p = r + beta * (p - omega * v)
+        scale_and_add(p, (rho_next / rho) * (alpha / omega), r);
+        precondition(preconditioner, p, p_hat);
+        A.apply(p_hat, v);
+        data_type r_hat_v = dot(r_hat, v, reduction_workspace);
+        if(r_hat_v == 0)
+            break;
+        alpha = rho_next / r_hat_v;
+        solution.add_scaled(p_hat, alpha);
+        r.add_scaled(v, -alpha); // r holds s from now on
+        residual = norm(r, reduction_workspace) / rhs_norm;
+        if(residual <= tolerance)
+            break;
+        precondition(preconditioner, r, s_hat);
+        A.apply(s_hat, t);
+        data_type tt = dot(t, t, reduction_workspace);
+        if(tt == 0)
+            break;
+        omega = dot(t, r, reduction_workspace) / tt;
+        solution.add_scaled(s_hat, omega);
+        r.add_scaled(t, -omega);
+        residual = norm(r, reduction_workspace) / rhs_norm;
+        rho = rho_next;
+        if(omega == 0) // the next iteration would divide by zero
+            break;
+    }
+    store(solution, x);
+    return {residual <= tolerance, iteration, residual};
+}
+
+Solver_Result Krylov_Solver::gmres(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner){ // restarted GMRES(restart)
+    MATRICES_TIMED_SCOPE(Solve);
+    MATRICES_RECORD(Solve, 0, 0);
+    size_t n = validate(A, b, x, preconditioner);
+    size_t m = restart;
+    prepare(n, 4 + m + 1);
+    Base_Vector &rhs = workspace[0], &solution = workspace[1], &w = workspace[2], &z = workspace[3];
+    Base_Vector* basis = &workspace[4]; // m + 1 orthonormal vectors
+    small_workspace.assign((m + 1) * m + 2 * m + (m + 1) + m, 0);
+    data_type* H = small_workspace.data(); // (m + 1) x m upper Hessenberg matrix, column major
+    data_type* cosines = H + (m + 1) * m;
+    data_type* sines = cosines + m;
+    data_type* g = sines + m; // right hand side of the least squares problem, rotated together with H
+    data_type* y = g + m + 1;
+    auto h = [H, m](size_t i, size_t j) -> data_type& { return H[i + j * (m + 1)]; };
+
+    load(b, rhs);
+    load(x, solution);
+    data_type rhs_norm = norm(rhs, reduction_workspace);
+    if(rhs_norm == 0){ // the solution is zero
+        std::fill(solution.data(), solution.data() + n, 0);
+        store(solution, x);
+        return {true, 0, 0};
+    }
+
+    data_type residual{};
+    size_t iteration{};
+    while(true){
+        residual_of(A, rhs, solution, w);
+        data_type beta = norm(w, reduction_workspace);
+        residual = beta / rhs_norm;
+        if(residual <= tolerance || iteration >= max_iterations)
+            break;
+        basis[0] = w;
+        basis[0] *= 1 / beta;
+        std::fill(g, g + m + 1, 0);
+        g[0] = beta;
+
+        size_t j{}; // number of basis vectors used for the correction
+        while(j < m && iteration < max_iterations){
+            precondition(preconditioner, basis[j], z);
+            A.apply(z, w);
+            iteration++;
+            for(size_t i{} ; i <= j ; i++){ // modified Gram-Schmidt
+                h(i, j) = dot(w, basis[i], reduction_workspace);
+                w.add_scaled(basis[i], -h(i, j));
+            }
+            h(j + 1, j) = norm(w, reduction_workspace);
+            for(size_t i{} ; i < j ; i++){ // previous Givens rotations
+                data_type upper = cosines[i] * h(i, j) + sines[i] * h(i + 1, j);
+                h(i + 1, j) = -sines[i] * h(i, j) + cosines[i] * h(i + 1, j);
+                h(i, j) = upper;
+            }
+            data_type denominator = std::hypot(h(j, j), h(j + 1, j));
+            if(denominator == 0) // the new column is zero, the basis cannot be extended
+                break;
+            data_type next_norm = h(j + 1, j);
+            cosines[j] = h(j, j) / denominator;
+            sines[j] = h(j + 1, j) / denominator;
+            h(j, j) = denominator;
+            h(j + 1, j) = 0;
+            g[j + 1] = -sines[j] * g[j];
+            g[j] = cosines[j] * g[j];
+            j++;
+            residual = std::fabs(g[j]) / rhs_norm;
+            if(residual <= tolerance || next_norm == 0) // converged, or the Krylov space is invariant and the solution exact
+                break;
+            if(j < m){
+                basis[j] = w;
+                basis[j] *= 1 / next_norm;
+            }
+        }
+        if(j == 0) // no progress is possible
+            break;
+
+        for(size_t i{j} ; i-- > 0 ; ){ // H * y = g, H is upper triangular after the rotations
+            data_type sum = g[i];
+            for(size_t k{i + 1} ; k < j ; k++)
+                sum -= h(i, k) * y[k];
+            y[i] = sum / h(i, i);
+        }
+        std::fill(w.data(), w.data() + n, 0);
+        for(size_t i{} ; i < j ; i++)
+            w.add_scaled(basis[i], y[i]);
+        precondition(preconditioner, w, z);
+        solution.add_scaled(z, 1);
+    }
+    store(solution, x);
+    return {residual <= tolerance, iteration, residual};
+}
@@ -0,0 +1,68 @@
+#ifndef _KRYLOV_SOLVER_H_
+#define _KRYLOV_SOLVER_H_
+
+// Krylov_Solver solves A * x = b iteratively, A is only ever used through matrix-vector products
+// conjugate_gradient needs a symmetric positive definite A, bicgstab and gmres work with any non singular A
+// A can be a dense Base_Matrix, a Sparse_Matrix or any callback computing output = A * input (matrix free), see Linear_Operator
+// the preconditioner is optional (nullptr means none), CG applies it symmetrically, BiCGSTAB and GMRES apply it from the right
+// the solver keeps its workspace vectors and the partial sums of its reductions between the calls, so after the first solve of a given size
+// the iterations do not allocate (the threads of the parallel loops aside, see Parallel.h)
+// x is used as the initial guess when it has the length of b, otherwise it is replaced by zeros of the shape of b
+// the iteration stops when |b - A * x| <= tolerance * |b| (euclidean norms) or when the iteration limit is reached
+
+#include <functional>
+#include <vector>
+#include "Base_Matrix.h"
+#include "Sparse_Matrix.h"
+#include "Preconditioner.h"
+#include "Reduction.h"
+#include "Vector.h"
+
+class Linear_Operator{
+    size_t size;
+    std::function<void(const Base_Vector &input, Base_Vector &output)> product;
+
+public:
+    Linear_Operator(const Base_Matrix &matrix); // keeps a reference, the matrix has to outlive the operator
+    Linear_Operator(const Sparse_Matrix &matrix); // keeps a reference, the matrix has to outlive the operator
+    Linear_Operator(size_t size, std::function<void(const Base_Vector &input, Base_Vector &output)> product); // matrix free operator
+
+    size_t get_size() const { return size; }
+    void apply(const Base_Vector &input, Base_Vector &output) const { product(input, output); } // output = A * input
+};
+
+struct Solver_Result{
+    bool converged;
+    size_t iterations; // iterations of the method (CG and GMRES use one product with A per iteration, BiCGSTAB two)
+    data_type relative_residual; // |b - A * x| / |b| of the returned x, as estimated by the method
+};
+
+class Krylov_Solver{
+    data_type tolerance;
+    size_t max_iterations;
+    size_t restart; // size of the Krylov basis of GMRES
+    std::vector<Base_Vector> workspace;
+    std::vector<data_type> small_workspace; // Hessenberg matrix, rotations and right hand side of GMRES
+    Reduction_Workspace reduction_workspace; // partial sums of the dot products and norms
+
+    void prepare(size_t length, size_t count); // makes sure the workspace holds count vectors of the given length
+
+public:
+// ========================================================================================================================================== constructors
+    Krylov_Solver(data_type tolerance = 1e-8, size_t max_iterations = 1000, size_t restart = 30);
+
+// ========================================================================================================================================== getters and setters
+    data_type get_tolerance() const { return tolerance; }
+    size_t get_max_iterations() const { return max_iterations; }
+    size_t get_restart() const { return restart; }
+    void set_tolerance(data_type tolerance);
+    void set_max_iterations(size_t max_iterations) { this->max_iterations = max_iterations; }
+    void set_restart(size_t restart);
+
+// ========================================================================================================================================== solvers
+    Solver_Result conjugate_gradient(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner = nullptr); // symmetric positive definite A
+    Solver_Result bicgstab(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner = nullptr); // stabilized bi-conjugate gradient
+    Solver_Result gmres(const Linear_Operator &A, const Vector &b, Vector &x, const Preconditioner* preconditioner = nullptr); // restarted GMRES(restart)
+};
+
+#endif // _KRYLOV_SOLVER_H_
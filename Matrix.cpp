@@ -1,6 +1,9 @@
 #include "Matrix.h"
-#include <time.h>
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include <algorithm>
 #include <array>
+#include <utility>
 #include <cmath>
 
 // ========================================================================================================================================== constructors and destructor
@@ -13,7 +16,7 @@ Matrix::Matrix(const std::initializer_list<Base_Vector> &init_list) : Base_Matri
 Matrix::Matrix(const Matrix &source) : Base_Matrix(source){ // copy constructor
 }
 
-Matrix::Matrix(Matrix &&source) : Base_Matrix(source){ // move contructor
+Matrix::Matrix(Matrix &&source) noexcept : Base_Matrix(std::move(source)){ // move contructor
 }
 
 Matrix::~Matrix(){
@@ -22,33 +25,43 @@ Matrix::~Matrix(){
 Matrix::Matrix(const Base_Matrix &source) : Base_Matrix(source){ // copy constructor
 }
 
-Matrix::Matrix(Base_Matrix &&source) : Base_Matrix(source){ // move contructor
+Matrix::Matrix(Base_Matrix &&source) noexcept : Base_Matrix(std::move(source)){ // move contructor
 }
 
 // ========================================================================================================================================== operators
+Matrix& Matrix::operator=(const Matrix &source){ // copy assignment
+    Base_Matrix::operator=(source);
+    return *this;
+}
+
+Matrix& Matrix::operator=(Matrix &&source) noexcept{ // move assignment
+    move_from(std::move(source));
+    return *this;
+}
+
 Matrix& Matrix::operator=(const Base_Matrix &source){ // copy assignment, copies from Base_Matrix
-    if(this == &source)
-        return *this;
-    rows = source.get_rows();
-    columns = source.get_columns();
-    delete[] rows_of_values;
-    rows_of_values = new Base_Vector[rows];
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = source[r];
+    Base_Matrix::operator=(source);
     return *this;
 }
 
-Matrix& Matrix::operator=(Base_Matrix &&source){ // move assignment
-    if(this == &source)
-        return *this;
-    rows = source.get_rows();
-    columns = source.get_columns();
-    delete[] rows_of_values;
-    rows_of_values = source.get_ptr();
-    source.set_ptr(nullptr);
+Matrix& Matrix::operator=(Base_Matrix &&source) noexcept{ // move assignment
+    move_from(std::move(source));
     return *this;
 }
 
+// ========================================================================================================================================== binary input and output
+Matrix Matrix::load(const std::string &path){ // reads the matrix from the binary file
+    Matrix loaded;
+    loaded.read_binary(path, false);
+    return loaded;
+}
+
+Matrix Matrix::map(const std::string &path){ // memory maps the binary file
+    Matrix mapped;
+    mapped.read_binary(path, true);
+    return mapped;
+}
+
 // ========================================================================================================================================== other mathematical operations
 Matrix Matrix::identity_matrix(size_t n){
     Matrix temp(n, n, 0);
@@ -58,6 +71,8 @@ Matrix Matrix::identity_matrix(size_t n){
 }
 
 Matrix Matrix::invert() const{ // matrix inversion using Gauss elimination algorithm
+    MATRICES_TIMED_SCOPE(Invert);
+    MATRICES_RECORD(Invert, 2 * rows * rows * rows, 2 * rows * rows * sizeof(data_type));
     if(columns != rows){
         std::cerr << "\nOnly square matrixs can be inverted... \n";
         throw Matrix();
@@ -74,21 +89,25 @@ Matrix Matrix::invert() const{ // matrix inversion using Gauss elimination algor
         left_augmented[r] /= left_augmented[r][r];
         
         for(size_t c{r + 1} ; c < rows ; c++){
-            right_augmented[c] -= right_augmented[r] * left_augmented[c][r];
-            left_augmented[c] -= left_augmented[r] * left_augmented[c][r];
+            data_type factor{left_augmented[c][r]};
+            right_augmented[c].add_scaled(right_augmented[r], -factor); // in place, no temporary rows
+            left_augmented[c].add_scaled(left_augmented[r], -factor);
         }
     }
     
     for(size_t r{rows - 2 + 1} ; r >= 1 ; r--){ // addition of +1 because size_t is unsigned and cannot be lower than 0
         for(size_t c{rows - 1} ; c > r - 1 ; c--){
-            right_augmented[r - 1] -= right_augmented[c] * left_augmented[r - 1][c];
-            left_augmented[r - 1] -= left_augmented[c] * left_augmented[r - 1][c];
+            data_type factor{left_augmented[r - 1][c]};
+            right_augmented[r - 1].add_scaled(right_augmented[c], -factor);
+            left_augmented[r - 1].add_scaled(left_augmented[c], -factor);
         }
     }
     return right_augmented;
 }
 
 std::pair<Matrix, Matrix> Matrix::LU_decomposition(const Matrix &matrix){ // returns the lower and upper matrix from the given argument
+    MATRICES_TIMED_SCOPE(LU_Decomposition);
+    MATRICES_RECORD(LU_Decomposition, 2 * matrix.rows * matrix.rows * matrix.rows / 3, 3 * matrix.rows * matrix.rows * sizeof(data_type));
     if(matrix.columns != matrix.rows){
         std::cerr << "\nOnly square matrixs can be LU decomposed... \n";
         throw Matrix();
@@ -104,11 +123,8 @@ std::pair<Matrix, Matrix> Matrix::LU_decomposition(const Matrix &matrix){ // ret
         bool do_column_shift{true};
         bool stop_column_shift{false};
         while(U[r][r + column_shift] == 0 && r + row_shift < matrix.rows){
-            if(U[r + row_shift][r + column_shift] != 0){
-                Base_Vector temp{U[r]};
-                U[r] = U[r + row_shift];
-                U[r + row_shift] = temp;
-            }
+            if(U[r + row_shift][r + column_shift] != 0)
+                std::swap(U[r], U[r + row_shift]); // swaps only the pointers
             row_shift++;
         }
         if(U[r][r + column_shift] != 0)
@@ -126,14 +142,16 @@ std::pair<Matrix, Matrix> Matrix::LU_decomposition(const Matrix &matrix){ // ret
             if(U[r][r + column_shift] != 0){
                 data_type f{U[c][r + column_shift] / U[r][r + column_shift]};
                 L[c][r] = f;
-                U[c] -= U[r] * f;
+                U[c].add_scaled(U[r], -f);
             }
         }
     }
-    return {L, U};
+    return {std::move(L), std::move(U)};
 }
 
 data_type Matrix::determinant() const{ // returns the determinant value, calculated using LU decopmposition
+    MATRICES_TIMED_SCOPE(Determinant);
+    MATRICES_RECORD(Determinant, 0, 0);
     if(columns != rows){
         std::cerr << "\nDeterminant can be calculated for square matrices only... \n";
         throw Matrix();
@@ -145,8 +163,191 @@ data_type Matrix::determinant() const{ // returns the determinant value, calcula
     return det;
 }
 
+static void add_scaled(Matrix &target, const Matrix &source, data_type k){ // target += k * source, row by row
+    for(size_t r{} ; r < target.get_rows() ; r++)
+        target[r].add_scaled(source[r], k);
+}
+
+static void add_identity(Matrix &target, data_type k){ // target += k * I
+    for(size_t r{} ; r < target.get_rows() ; r++)
+        target[r][r] += k;
+}
+
+static void solve_in_place(Matrix &A, Matrix &B){ // B becomes A^-1 * B, Gauss elimination with partial pivoting, A is destroyed
+    size_t n = A.get_rows();
+    size_t width = B.get_columns();
+    size_t rows_per_chunk = (1 << 16) / (n + width + 1) + 1;
+    Base_Vector* rows_of_A = A.get_ptr();
+    Base_Vector* rows_of_B = B.get_ptr();
+    for(size_t p{} ; p < n ; p++){
+        size_t pivot{p};
+        for(size_t r{p + 1} ; r < n ; r++)
+            if(std::abs(A[r][p]) > std::abs(A[pivot][p]))
+                pivot = r;
+        if(A[pivot][p] == 0){
+            std::cerr << "\nThe system is singular... \n";
+            throw Matrix();
+        }
+        std::swap(A[p], A[pivot]); // swaps only the pointers
+        std::swap(B[p], B[pivot]);
+        const data_type* pivot_row = A[p].data();
+        const data_type* pivot_right = B[p].data();
+        Parallel::for_range(p + 1, n, rows_per_chunk, [&](size_t first, size_t last){
+            for(size_t r{first} ; r < last ; r++){
+                data_type* row = rows_of_A[r].data();
+                data_type factor{row[p] / pivot_row[p]};
+                if(factor == 0)
+                    continue;
+                for(size_t c{p + 1} ; c < n ; c++)
+                    row[c] -= factor * pivot_row[c];
+                data_type* right = rows_of_B[r].data();
+                for(size_t c{} ; c < width ; c++)
+                    right[c] -= factor * pivot_right[c];
+            }
+        });
+    }
+    for(size_t p{n} ; p-- > 0 ; ){ // back substitution, one pivot row at a time
+        B[p] /= A[p][p];
+        const data_type* pivot_right = B[p].data();
+        Parallel::for_range(0, p, rows_per_chunk, [&](size_t first, size_t last){
+            for(size_t r{first} ; r < last ; r++){
+                data_type factor{rows_of_A[r][p]};
+                data_type* right = rows_of_B[r].data();
+                for(size_t c{} ; c < width ; c++)
+                    right[c] -= factor * pivot_right[c];
+            }
+        });
+    }
+}
+
+Matrix Matrix::power(size_t exponent) const{ // this^exponent by binary exponentiation, no allocation per step
+    if(columns != rows){
+        std::cerr << "\nOnly square matrices can be raised to a power... \n";
+        throw Matrix();
+    }
+    if(exponent == 0)
+        return Matrix::identity_matrix(rows);
+
+    Matrix base(*this);
+    Matrix scratch(columns, rows);
+    while((exponent & 1) == 0){ // the lowest set bit starts the result, no product with the identity
+        Base_Matrix::multiply(base, base, scratch, multiplication_policy);
+        std::swap(base, scratch);
+        exponent >>= 1;
+    }
+    Matrix result(base);
+    exponent >>= 1;
+    while(exponent != 0){
+        Base_Matrix::multiply(base, base, scratch, multiplication_policy);
+        std::swap(base, scratch);
+        if(exponent & 1){
+            Base_Matrix::multiply(result, base, scratch, multiplication_policy);
+            std::swap(result, scratch);
+        }
+        exponent >>= 1;
+    }
+    return result;
+}
+
+Matrix Matrix::exp() const{ // matrix exponential, scaling and squaring with a Pade approximant of degree 3 to 13
+    if(columns != rows){
+        std::cerr << "\nOnly square matrices have an exponential... \n";
+        throw Matrix();
+    }
+    static const data_type theta[]{1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0}; // largest norms for the degrees 3, 5, 7, 9 and 13
+    static const data_type b3[]{120, 60, 12, 1};
+    static const data_type b5[]{30240, 15120, 3360, 420, 30, 1};
+    static const data_type b7[]{17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1};
+    static const data_type b9[]{17643225600., 8821612800., 2075673600., 302702400., 30270240., 2162160., 110880., 3960., 90., 1.};
+    static const data_type b13[]{64764752532480000., 32382376266240000., 7771770303897600., 1187353796428800., 129060195264000.,
+        10559470521600., 670442572800., 33522128640., 1323241920., 40840800., 960960., 16380., 182., 1.};
+
+    data_type norm{norm_1()};
+    if(std::isnan(norm) || std::isinf(norm)){
+        std::cerr << "\nThe matrix has non finite values... \n";
+        throw Matrix();
+    }
+    Matrix A(*this);
+    size_t squarings{};
+    const data_type* b{b13};
+    size_t degree{13};
+    const data_type* low_degrees[]{b3, b5, b7, b9};
+    for(size_t d{} ; d < 4 ; d++)
+        if(norm <= theta[d]){
+            b = low_degrees[d];
+            degree = 2 * d + 3;
+            break;
+        }
+    if(degree == 13 && norm > theta[4]){
+        squarings = static_cast<size_t>(std::ceil(std::log2(norm / theta[4])));
+        A *= std::ldexp(1.0, -static_cast<int>(squarings)); // exact, only the exponents change
+    }
+
+    Matrix A2(columns, rows);
+    Base_Matrix::multiply(A, A, A2, multiplication_policy);
+    Matrix U_inner(columns, rows); // odd part before the multiplication by A
+    Matrix V(columns, rows); // even part
+    if(degree < 13){
+        std::vector<Matrix> even_powers; // A^2, A^4, ... up to A^(degree - 1)
+        even_powers.push_back(A2);
+        for(size_t p{4} ; p < degree ; p += 2){
+            even_powers.emplace_back(columns, rows);
+            Base_Matrix::multiply(even_powers[even_powers.size() - 2], A2, even_powers.back(), multiplication_policy);
+        }
+        add_identity(U_inner, b[1]);
+        add_identity(V, b[0]);
+        for(size_t p{} ; p < even_powers.size() ; p++){
+            add_scaled(U_inner, even_powers[p], b[2 * p + 3]);
+            add_scaled(V, even_powers[p], b[2 * p + 2]);
+        }
+    }
+    else{
+        Matrix A4(columns, rows);
+        Matrix A6(columns, rows);
+        Base_Matrix::multiply(A2, A2, A4, multiplication_policy);
+        Base_Matrix::multiply(A4, A2, A6, multiplication_policy);
+        Matrix inner(columns, rows);
+        add_scaled(inner, A6, b[13]);
+        add_scaled(inner, A4, b[11]);
+        add_scaled(inner, A2, b[9]);
+        Base_Matrix::multiply(A6, inner, U_inner, multiplication_policy);
+        add_scaled(U_inner, A6, b[7]);
+        add_scaled(U_inner, A4, b[5]);
+        add_scaled(U_inner, A2, b[3]);
+        add_identity(U_inner, b[1]);
+
+        for(size_t r{} ; r < rows ; r++)
+            std::fill(inner[r].data(), inner[r].data() + columns, 0.0);
+        add_scaled(inner, A6, b[12]);
+        add_scaled(inner, A4, b[10]);
+        add_scaled(inner, A2, b[8]);
+        Base_Matrix::multiply(A6, inner, V, multiplication_policy);
+        add_scaled(V, A6, b[6]);
+        add_scaled(V, A4, b[4]);
+        add_scaled(V, A2, b[2]);
+        add_identity(V, b[0]);
+    }
+    Matrix U(columns, rows);
+    Base_Matrix::multiply(A, U_inner, U, multiplication_policy);
+
+    Matrix denominator(V); // r(A) = (V - U)^-1 * (V + U)
+    add_scaled(denominator, U, -1);
+    add_scaled(V, U, 1);
+    solve_in_place(denominator, V);
+
+    for(size_t s{} ; s < squarings ; s++){ // exp(A) = exp(A / 2^s)^(2^s), U is free to be the second buffer
+        Base_Matrix::multiply(V, V, U, multiplication_policy);
+        std::swap(V, U);
+    }
+    return V;
+}
+
 // ========================================================================================================================================== random generation
 Matrix Matrix::generate_random(size_t columns, size_t rows, data_type lower_limit, data_type upper_limit, data_type precission){ // random Matrix of given size generator
+    return Matrix::generate_random(columns, rows, Random_Generator(), lower_limit, upper_limit, precission); // fresh seed on every call
+}
+
+Matrix Matrix::generate_random(size_t columns, size_t rows, const Random_Generator &generator, data_type lower_limit, data_type upper_limit, data_type precission){ // reproducible version, uses the given generator
     if(precission == 0){
         std::cerr << "\nPrecission cannot be equal to 0... \n";
         throw Matrix();
@@ -156,26 +357,30 @@ Matrix Matrix::generate_random(size_t columns, size_t rows, data_type lower_limi
         throw Matrix();
     }
     
-    upper_limit /= precission; // dividing by precision to achieve random fractions
-    lower_limit /= precission;
-    int random_remainder{static_cast<int>(std::ceil((upper_limit - lower_limit + 1)))}; // random numbers are the remainders of dividing rand() by this number
+    data_type lower_step{std::ceil(lower_limit / precission - 1e-9)}; // dividing by precision to achieve random fractions
+    data_type upper_step{std::floor(upper_limit / precission + 1e-9)};
     
-    if(random_remainder > static_cast<int>(RAND_MAX)){
-        std::cerr << "\nRandom matrix generator range is too big, ((upper_limit - lower_limit) / precission) value is too big... \n";
+    if(upper_step < lower_step || std::fabs(lower_step) > 9e18 || std::fabs(upper_step) > 9e18){
+        std::cerr << "\nRandom matrix generator range is invalid, ((upper_limit - lower_limit) / precission) value is too big or too small... \n";
         throw Matrix();
     }
     
     Matrix random(columns, rows);
-    srand(time(nullptr));
-    
-    for(size_t r{} ; r < random.rows ; r++)
-        for(size_t c{} ; c < random.columns ; c++){
-            random[r][c] = rand() % random_remainder + lower_limit; // upper_limit is subtracted to achieve negative numbers
-            random[r][c] *= precission; // back to given precission
-        }
+    generator.fill_integer(random, static_cast<int64_t>(lower_step), static_cast<int64_t>(upper_step), precission); // back to given precission
     return random;
 }
 
+Matrix Matrix::generate_uniform(size_t columns, size_t rows, const Random_Generator &generator, data_type lower_limit, data_type upper_limit){ // uniform values from [lower_limit, upper_limit)
+    Matrix random(columns, rows);
+    generator.fill_uniform(random, lower_limit, upper_limit);
+    return random;
+}
+
+Matrix Matrix::generate_normal(size_t columns, size_t rows, const Random_Generator &generator, data_type mean, data_type standard_deviation){ // normally distributed values
+    Matrix random(columns, rows);
+    generator.fill_normal(random, mean, standard_deviation);
+    return random;
+}
 
 
 
@@ -2,6 +2,7 @@
 #define _MATRIX_H_
 
 #include "Base_Matrix.h"
+#include "Random_Generator.h"
 
 // Matrix is a sub class of Base_Class, that provides functionalities for Matrixs that are supposed to have both dimensions bigger than 1 (Matrix can be used as a "Vector", withou being a Vector)
 // Matrix provides all the funtionalities that would be impossible for the 1 dimensional Vector (for example Matrix inversion)
@@ -16,24 +17,35 @@ public:
     Matrix(size_t columns = 1, size_t rows = 1, data_type init_value = 0); // default constructor
     Matrix(const std::initializer_list<Base_Vector> &init_list); // initializer list constructor
     Matrix(const Matrix &source); // copy constructor
-    Matrix(Matrix &&source); // move contructor
+    Matrix(Matrix &&source) noexcept; // move contructor
     virtual ~Matrix();
     
     Matrix(const Base_Matrix &source); // copy constructor, copies from Base_Matrix
-    Matrix(Base_Matrix &&source); // move contructor, moves Base_Matrix object
+    Matrix(Base_Matrix &&source) noexcept; // move contructor, moves Base_Matrix object
     
 // ========================================================================================================================================== operators
+    Matrix& operator=(const Matrix &source); // copy assignment
+    Matrix& operator=(Matrix &&source) noexcept; // move assignment
     virtual Matrix& operator=(const Base_Matrix &source); // copy assignment, copies from Base_Matrix
-    virtual Matrix& operator=(Base_Matrix &&source); // move assignment, moves Base_Matrix object
+    virtual Matrix& operator=(Base_Matrix &&source) noexcept; // move assignment, moves Base_Matrix object
+
+// ========================================================================================================================================== binary input and output
+    static Matrix load(const std::string &path); // reads the matrix from the binary file
+    static Matrix map(const std::string &path); // memory maps the binary file, rows are backed directly by the file
 
 // ========================================================================================================================================== other mathematical operations
     static Matrix identity_matrix(size_t n); // creates an identity matrix of size n (square matrix with ones at the main diagonal) (static function)
     virtual Matrix invert() const; // matrix inversion using Gauss elimination algorithm
     static std::pair<Matrix, Matrix> LU_decomposition(const Matrix &matrix); // returns the lower and upper matrix from the given argument
     data_type determinant() const; // returns the determinant value, calculated using LU decopmposition
+    Matrix power(size_t exponent) const; // this^exponent by binary exponentiation, no allocation per step
+    Matrix exp() const; // matrix exponential, scaling and squaring with a Pade approximant of degree 3 to 13
     
 // ========================================================================================================================================== random generation
     static Matrix generate_random(size_t columns, size_t rows, data_type lower_limit = -10, data_type upper_limit = 10, data_type precission = 0.1); // random matrix of given size generator
+    static Matrix generate_random(size_t columns, size_t rows, const Random_Generator &generator, data_type lower_limit = -10, data_type upper_limit = 10, data_type precission = 0.1); // reproducible version, uses the given generator
+    static Matrix generate_uniform(size_t columns, size_t rows, const Random_Generator &generator, data_type lower_limit = 0, data_type upper_limit = 1); // uniform values from [lower_limit, upper_limit)
+    static Matrix generate_normal(size_t columns, size_t rows, const Random_Generator &generator, data_type mean = 0, data_type standard_deviation = 1); // normally distributed values
 };
 
 #endif // _MATRIX_H_
@@ -0,0 +1,194 @@
+#include "Matrix_Reader.h"
+#include <charconv>
+#include <cstring>
+#include <sys/stat.h>
+
+// ========================================================================================================================================== constructors and destructor
+Matrix_Reader::Matrix_Reader(const std::string &path, char delimiter, bool skip_header, size_t chunk_size)
+    : file{nullptr}, buffer(chunk_size < 64 ? 64 : chunk_size), position{0}, filled{0}, end_of_file{false}, delimiter{delimiter}, columns{0}, line{0}, consumed{0}, pending{false}{
+    file = std::fopen(path.c_str(), "rb");
+    if(file == nullptr){
+        std::cerr << "\nCannot open the file for reading... \n";
+        throw Matrix();
+    }
+    if(skip_header){
+        const char* begin{nullptr};
+        const char* end{nullptr};
+        next_line(begin, end);
+    }
+}
+
+Matrix_Reader::~Matrix_Reader(){
+    std::fclose(file);
+}
+
+// ========================================================================================================================================== getters and setters
+size_t Matrix_Reader::get_columns(){ // number of values in every row, parses the first row if needed
+    if(columns == 0 && parse_row())
+        pending = true;
+    return columns;
+}
+
+// ========================================================================================================================================== parsing
+bool Matrix_Reader::next_line(const char* &begin, const char* &end){ // finds the next line, refills the buffer when needed
+    for(;;){
+        if(position < filled){
+            char* start = buffer.data() + position;
+            char* new_line = static_cast<char*>(std::memchr(start, '\n', filled - position));
+            if(new_line != nullptr || end_of_file){
+                begin = start;
+                end = (new_line != nullptr) ? new_line : buffer.data() + filled;
+                position = end - buffer.data() + ((new_line != nullptr) ? 1 : 0);
+                consumed += buffer.data() + position - start;
+                if(end > begin && end[-1] == '\r') // windows line endings
+                    end--;
+                line++;
+                return true;
+            }
+        }
+        else if(end_of_file)
+            return false;
+        
+        size_t remaining = filled - position; // keep the incomplete line and read the next chunk after it
+        std::memmove(buffer.data(), buffer.data() + position, remaining);
+        position = 0;
+        filled = remaining;
+        if(filled == buffer.size()) // line longer than the chunk
+            buffer.resize(2 * buffer.size());
+        size_t count = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file);
+        if(count == 0 && std::ferror(file)){
+            std::cerr << "\nReading the file failed... \n";
+            throw Matrix();
+        }
+        filled += count;
+        end_of_file = (count == 0);
+    }
+}
+
+bool Matrix_Reader::parse_row(){ // parses the next non empty line into fields
+    if(pending){
+        pending = false;
+        return true;
+    }
+    const char* begin{nullptr};
+    const char* end{nullptr};
+    while(next_line(begin, end)){
+        auto is_blank = [this](char c){ return c == ' ' || (c == '\t' && delimiter != '\t'); };
+        const char* p = begin;
+        while(p != end && is_blank(*p))
+            p++;
+        if(p == end) // empty line
+            continue;
+        
+        fields.clear();
+        for(;;){
+            if(p != end && *p == '+') // from_chars does not accept the plus sign
+                p++;
+            data_type value{};
+            auto result = std::from_chars(p, end, value);
+            if(result.ec != std::errc()){
+                std::cerr << "\nInvalid number in line " << line << "... \n";
+                throw Matrix();
+            }
+            fields.push_back(value);
+            p = result.ptr;
+            while(p != end && is_blank(*p))
+                p++;
+            if(p == end)
+                break;
+            if(delimiter != ' '){
+                if(*p != delimiter){
+                    std::cerr << "\nUnexpected character in line " << line << "... \n";
+                    throw Matrix();
+                }
+                p++;
+                while(p != end && is_blank(*p))
+                    p++;
+            }
+        }
+        
+        if(columns == 0)
+            columns = fields.size();
+        else if(fields.size() != columns){
+            std::cerr << "\nLine " << line << " has a different number of values than the first row... \n";
+            throw Matrix();
+        }
+        return true;
+    }
+    return false;
+}
+
+// ========================================================================================================================================== reading
+bool Matrix_Reader::read_row(Base_Vector &row){ // reads the next row, returns false at the end of the file
+    if(!parse_row())
+        return false;
+    if(row.get_length() != columns || row.data() == nullptr)
+        row = Base_Vector(columns);
+    std::memcpy(row.data(), fields.data(), columns * sizeof(data_type));
+    return true;
+}
+
+size_t Matrix_Reader::read_rows(Base_Matrix &block){ // fills the existing rows of the block in place, returns the number of rows read
+    if(block.get_columns() != get_columns()){
+        std::cerr << "\nBlock must have the same number of columns as the file... \n";
+        throw Matrix();
+    }
+    size_t count{};
+    while(count < block.get_rows() && parse_row()){
+        std::memcpy(block[count].data(), fields.data(), columns * sizeof(data_type));
+        count++;
+    }
+    return count;
+}
+
+void Matrix_Reader::for_each_block(size_t block_rows, const std::function<void(const Matrix &block)> &callback){ // processes the rest of the file block by block
+    if(get_columns() == 0)
+        return;
+    Matrix block(columns, block_rows); // allocated once, reused by every block
+    for(;;){
+        size_t count = read_rows(block);
+        if(count == 0)
+            return;
+        while(block.get_rows() > count) // shorter last block
+            block.delete_row(block.get_rows() - 1);
+        callback(block);
+        if(count < block_rows)
+            return;
+    }
+}
+
+Matrix Matrix_Reader::read_all(){ // reads the rest of the file into a single Matrix
+    if(get_columns() == 0){
+        std::cerr << "\nFile does not contain any rows... \n";
+        throw Matrix();
+    }
+    Matrix result(columns, 1);
+    read_rows(result);
+    
+    // the first rows grow the matrix geometrically, their mean length then estimates the number of rows of the rest of the file
+    // a row takes at least 2 bytes per value (a digit and a delimiter or the end of line), so the estimate never exceeds what the file can hold
+    const size_t sample_rows{64};
+    size_t sample_start = consumed;
+    for(size_t appended{} ; ; appended++){
+        if(appended == sample_rows){
+            struct stat file_status{};
+            if(fstat(fileno(file), &file_status) == 0 && static_cast<size_t>(file_status.st_size) > consumed){
+                size_t remaining = static_cast<size_t>(file_status.st_size) - consumed;
+                size_t row_bytes = (consumed - sample_start) / sample_rows;
+                size_t estimate = remaining / (row_bytes > 0 ? row_bytes : 1);
+                size_t bound = remaining / (2 * columns);
+                result.reserve_rows(result.get_rows() + (estimate < bound ? estimate : bound) + 1);
+            }
+        }
+        Base_Vector row(columns);
+        if(!read_row(row))
+            break;
+        result.append_row(std::move(row));
+    }
+    return result;
+}
+
+Matrix Matrix_Reader::read(const std::string &path, char delimiter, bool skip_header){ // reads the whole file
+    Matrix_Reader reader(path, delimiter, skip_header);
+    return reader.read_all();
+}
@@ -0,0 +1,50 @@
+#ifndef _MATRIX_READER_H_
+#define _MATRIX_READER_H_
+
+// Matrix_Reader is a streaming parser of numeric text files (CSV, TSV or whitespace separated values, like the output of operator<<)
+// the file is read in chunks of fixed size and parsed with std::from_chars, only the current chunk is held in memory
+// rows can be read one by one, in blocks of fixed size, or all at once into a Matrix with preallocated row capacity
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Matrix.h"
+
+class Matrix_Reader{
+    std::FILE* file;
+    std::vector<char> buffer; // current chunk of the file
+    size_t position; // first unparsed byte of the buffer
+    size_t filled; // number of valid bytes in the buffer
+    bool end_of_file;
+    char delimiter; // ' ' means any amount of spaces and tabs
+    size_t columns; // 0 until the first row is parsed
+    size_t line;
+    size_t consumed; // bytes of the file parsed so far, used to estimate the number of rows of the file
+    bool pending; // fields hold a parsed row that was not consumed yet
+    std::vector<data_type> fields; // values of the last parsed row
+
+    bool next_line(const char* &begin, const char* &end); // finds the next line, refills the buffer when needed
+    bool parse_row(); // parses the next non empty line into fields
+
+public:
+// ========================================================================================================================================== constructors and destructor
+    Matrix_Reader(const std::string &path, char delimiter = ',', bool skip_header = false, size_t chunk_size = 1 << 20);
+    Matrix_Reader(const Matrix_Reader &source) = delete;
+    Matrix_Reader &operator=(const Matrix_Reader &source) = delete;
+    ~Matrix_Reader();
+
+// ========================================================================================================================================== getters and setters
+    size_t get_columns(); // number of values in every row, parses the first row if needed
+    size_t get_line() const { return line; } // number of lines consumed so far
+
+// ========================================================================================================================================== reading
+    bool read_row(Base_Vector &row); // reads the next row, returns false at the end of the file
+    size_t read_rows(Base_Matrix &block); // fills the existing rows of the block in place, returns the number of rows read
+    void for_each_block(size_t block_rows, const std::function<void(const Matrix &block)> &callback); // processes the rest of the file block by block, the last block may be shorter
+    Matrix read_all(); // reads the rest of the file into a single Matrix
+
+    static Matrix read(const std::string &path, char delimiter = ',', bool skip_header = false); // reads the whole file
+};
+
+#endif // _MATRIX_READER_H_
@@ -0,0 +1,99 @@
+#include "Matrix_Writer.h"
+#include <charconv>
+#include <cstring>
+
+static const size_t max_shortest_length{32}; // longest shortest round trip representation of a double
+static const size_t max_fixed_integer_digits{310}; // digits before the decimal point of the largest double
+
+// ========================================================================================================================================== constructors and destructor
+Matrix_Writer::Matrix_Writer(std::ostream &os, const Output_Format &format, size_t buffer_size) : os{os}, format{format}, buffer(buffer_size < 1024 ? 1024 : buffer_size), used{0}{
+}
+
+Matrix_Writer::~Matrix_Writer(){ // flushes the remaining buffer
+    flush();
+}
+
+// ========================================================================================================================================== buffer
+void Matrix_Writer::reserve(size_t length){ // makes sure the buffer has at least length free bytes
+    if(buffer.size() - used >= length)
+        return;
+    flush();
+    if(buffer.size() < length)
+        buffer.resize(length);
+}
+
+void Matrix_Writer::put(char c){
+    reserve(1);
+    buffer[used++] = c;
+}
+
+void Matrix_Writer::put(const char* text, size_t length){
+    reserve(length);
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void Matrix_Writer::put_value(data_type value, bool first){ // delimiter (if not first) and the formatted value
+    bool aligned = format.delimiter == ' ';
+    size_t length = 2 + ((format.precision < 0) ? max_shortest_length : max_fixed_integer_digits + format.precision + 2);
+    reserve(length);
+
+    char* begin = buffer.data() + used;
+    char* end = buffer.data() + buffer.size();
+    if(!first && !aligned) // the aligned layout ends every value with a space instead
+        *begin++ = format.delimiter;
+    if(aligned && !(value < 0)) // place for the minus sign, so that the columns line up
+        *begin++ = ' ';
+    std::to_chars_result result = (format.precision < 0) ? std::to_chars(begin, end, value) : std::to_chars(begin, end, value, std::chars_format::fixed, format.precision);
+    begin = result.ptr;
+    if(aligned)
+        *begin++ = ' ';
+    used = begin - buffer.data();
+}
+
+void Matrix_Writer::put_row(const data_type* values, size_t length){ // one row, summarized if needed, without the line break
+    bool summarized = format.summarize_above != 0 && length > format.summarize_above && length > 2 * format.edge_items;
+    if(!summarized){
+        for(size_t i{} ; i < length ; i++)
+            put_value(values[i], i == 0);
+        return;
+    }
+    for(size_t i{} ; i < format.edge_items ; i++)
+        put_value(values[i], i == 0);
+    if(format.delimiter == ' ')
+        put(" ... ", 5);
+    else{
+        if(format.edge_items > 0)
+            put(format.delimiter);
+        put("...", 3);
+    }
+    for(size_t i{length - format.edge_items} ; i < length ; i++)
+        put_value(values[i], false);
+}
+
+void Matrix_Writer::flush(){ // passes the buffer to the stream
+    if(used == 0)
+        return;
+    os.write(buffer.data(), used);
+    used = 0;
+}
+
+// ========================================================================================================================================== writing
+void Matrix_Writer::write(const Base_Vector &base_vector){ // values of the Base_Vector, without a line break
+    put_row(base_vector.data(), base_vector.get_length());
+}
+
+void Matrix_Writer::write(const Base_Matrix &base_matrix){ // every row ends with a line break
+    size_t rows = base_matrix.get_rows();
+    bool summarized = format.summarize_above != 0 && rows > format.summarize_above && rows > 2 * format.edge_items;
+    for(size_t r{} ; r < rows ; r++){
+        if(summarized && r == format.edge_items){
+            put("...\n", 4);
+            r = rows - format.edge_items;
+            if(r >= rows)
+                break;
+        }
+        put_row(base_matrix[r].data(), base_matrix.get_columns());
+        put('\n');
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef _MATRIX_WRITER_H_
+#define _MATRIX_WRITER_H_
+
+// Matrix_Writer formats Base_Vectors and Base_Matrices with std::to_chars into its own buffer and writes whole buffers to the stream
+// the stream is not flushed after every row and its formatting flags are not touched
+// Output_Format selects the precision, the delimiter (aligned layout of operator<<, CSV or TSV) and the summarized view of huge matrices
+
+#include <iostream>
+#include <vector>
+#include "Base_Matrix.h"
+
+struct Output_Format{
+    int precision{3}; // digits after the decimal point, negative means the shortest representation that reads back exactly
+    char delimiter{' '}; // ' ' gives the aligned layout of operator<<, ',' gives CSV and '\t' gives TSV
+    size_t summarize_above{0}; // matrices with more rows or columns than this show only their edges, 0 never summarizes
+    size_t edge_items{3}; // rows and columns shown at each edge of a summarized matrix
+
+    static Output_Format aligned(int precision = 3) { return Output_Format{precision, ' ', 0, 3}; }
+    static Output_Format csv(int precision = -1) { return Output_Format{precision, ',', 0, 3}; }
+    static Output_Format tsv(int precision = -1) { return Output_Format{precision, '\t', 0, 3}; }
+    static Output_Format summary(size_t edge_items = 3, int precision = 3) { return Output_Format{precision, ' ', 2 * edge_items, edge_items}; }
+};
+
+class Matrix_Writer{
+    std::ostream &os;
+    Output_Format format;
+    std::vector<char> buffer;
+    size_t used; // number of bytes waiting in the buffer
+
+    void reserve(size_t length); // makes sure the buffer has at least length free bytes
+    void put(char c);
+    void put(const char* text, size_t length);
+    void put_value(data_type value, bool first); // delimiter (if not first) and the formatted value
+    void put_row(const data_type* values, size_t length); // one row, summarized if needed, without the line break
+
+public:
+// ========================================================================================================================================== constructors and destructor
+    Matrix_Writer(std::ostream &os, const Output_Format &format = Output_Format(), size_t buffer_size = 1 << 16);
+    Matrix_Writer(const Matrix_Writer &source) = delete;
+    Matrix_Writer &operator=(const Matrix_Writer &source) = delete;
+    ~Matrix_Writer(); // flushes the remaining buffer
+
+// ========================================================================================================================================== writing
+    void write(const Base_Vector &base_vector); // values of the Base_Vector, without a line break
+    void write(const Base_Matrix &base_matrix); // every row ends with a line break
+    void flush(); // passes the buffer to the stream
+};
+
+#endif // _MATRIX_WRITER_H_
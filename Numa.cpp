@@ -0,0 +1,161 @@
+#include "Numa.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+Numa::Allocation_Policy Numa::allocation_policy{Numa::First_Touch};
+size_t Numa::interleave_threshold{1 << 21};
+bool Numa::pinning{false};
+
+static const int default_mode{0}; // MPOL_DEFAULT of <numaif.h>, which is part of libnuma and not always installed
+static const int interleave_mode{3}; // MPOL_INTERLEAVE
+
+struct Topology{
+    std::vector<int> nodes; // ids of the online nodes
+    std::vector<std::vector<int>> cpus; // usable cores of every node, nodes without usable cores are left out
+};
+
+static std::vector<int> parse_list(const std::string &text){ // "0-3,8,10-11" as used by sysfs
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string range;
+    while(std::getline(stream, range, ',')){
+        if(range.empty() || range[0] < '0' || range[0] > '9')
+            continue;
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+        for(int value{first} ; value <= last ; value++)
+            values.push_back(value);
+    }
+    return values;
+}
+
+static std::vector<int> read_list(const std::string &path){ // empty if the file does not exist
+    std::ifstream file(path);
+    std::string text;
+    if(!file || !std::getline(file, text))
+        return {};
+    try{
+        return parse_list(text);
+    }
+    catch(...){ // malformed file, treated as missing
+        return {};
+    }
+}
+
+static Topology read_topology(){ // read once, the usable cores are those of the process affinity at that time
+    Topology topology;
+    std::vector<int> allowed;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+        for(int cpu{} ; cpu < CPU_SETSIZE ; cpu++)
+            if(CPU_ISSET(cpu, &set))
+                allowed.push_back(cpu);
+#endif
+    topology.nodes = read_list("/sys/devices/system/node/online");
+    for(int node : topology.nodes){
+        std::vector<int> usable;
+        for(int cpu : read_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"))
+            for(int allowed_cpu : allowed)
+                if(cpu == allowed_cpu){
+                    usable.push_back(cpu);
+                    break;
+                }
+        if(!usable.empty())
+            topology.cpus.push_back(usable);
+    }
+    if(topology.nodes.empty())
+        topology.nodes.push_back(0);
+    if(topology.cpus.empty() && !allowed.empty()) // no sysfs, a single node with all the usable cores
+        topology.cpus.push_back(allowed);
+    return topology;
+}
+
+static const Topology &topology(){
+    static const Topology instance{read_topology()};
+    return instance;
+}
+
+// ========================================================================================================================================== getters and setters
+size_t Numa::get_node_count(){ // memory nodes of the machine, 1 without NUMA support
+    return topology().nodes.size();
+}
+
+const std::vector<std::vector<int>> &Numa::get_node_cpus(){ // cores of every node usable by the process
+    return topology().cpus;
+}
+
+static std::vector<unsigned long> node_mask(){ // all the online nodes, as the bit mask of the memory policy system calls
+    const size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(topology().nodes.back() / bits + 1, 0);
+    for(int node : topology().nodes)
+        mask[node / bits] |= 1UL << (node % bits);
+    return mask;
+}
+
+// ========================================================================================================================================== placement
+bool Numa::interleaves(size_t bytes){ // true if the allocation policy spreads a matrix or buffer of this size over the nodes
+    return allocation_policy == Interleaved && bytes >= interleave_threshold && get_node_count() >= 2;
+}
+
+void Numa::place(void* address, size_t bytes){ // applies the allocation policy to freshly allocated memory, before it is touched
+    if(!interleaves(bytes))
+        return;
+#ifdef __linux__
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = (reinterpret_cast<size_t>(address) + page - 1) / page * page; // only the whole pages inside the buffer
+    size_t end = (reinterpret_cast<size_t>(address) + bytes) / page * page;
+    if(end <= begin)
+        return;
+    std::vector<unsigned long> mask = node_mask();
+    syscall(SYS_mbind, begin, end - begin, interleave_mode, mask.data(), mask.size() * 8 * sizeof(unsigned long) + 1, 0); // on failure the pages stay first touch
+#endif
+}
+
+void Numa::set_thread_interleaving(bool enabled){ // pages first touched by the calling thread are spread over the nodes, or placed by the default policy again
+    if(get_node_count() < 2)
+        return;
+#ifdef __linux__
+    if(enabled){
+        std::vector<unsigned long> mask = node_mask();
+        syscall(SYS_set_mempolicy, interleave_mode, mask.data(), mask.size() * 8 * sizeof(unsigned long) + 1); // on failure the pages stay first touch
+    }
+    else
+        syscall(SYS_set_mempolicy, default_mode, nullptr, 0);
+#else
+    (void)enabled;
+#endif
+}
+
+int Numa::cpu_for(size_t index, size_t count){ // core of the thread index out of count, -1 if the cores are unknown
+    const auto &cpus = topology().cpus;
+    if(cpus.empty() || count == 0)
+        return -1;
+    size_t nodes = cpus.size();
+    size_t node = (index % count) * nodes / count; // contiguous blocks of threads share a node, like contiguous chunks of rows
+    size_t first = (node * count + nodes - 1) / nodes; // first thread index of the node
+    const auto &node_cpus = cpus[node];
+    return node_cpus[(index % count - first) % node_cpus.size()];
+}
+
+bool Numa::pin_thread(size_t index, size_t count){ // pins the calling thread to cpu_for(index, count), false if it could not be pinned
+    int cpu = cpu_for(index, count);
+    if(cpu < 0)
+        return false;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
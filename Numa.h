@@ -0,0 +1,43 @@
+#ifndef _NUMA_H_
+#define _NUMA_H_
+
+// Numa places the memory of large matrices and the threads processing it on the nodes of a multi socket machine (Linux only)
+// the rows of a big Base_Matrix are constructed in parallel, so their pages are first touched by the threads that later process the same rows
+// the Interleaved policy spreads the pages of large matrices over all nodes instead, which helps when the access pattern is not row partitioned
+// the threshold applies to the whole matrix: its rows are constructed by a thread whose memory policy interleaves, whatever the width of a row
+// with pinning enabled, chunk t of a parallel loop and worker t of an Executor run on a fixed core, the cores are taken node by node,
+// so a contiguous row range always lands on the same node as the pages it first touched
+// the topology is read from /sys/devices/system/node, on a single node machine (or without sysfs) the memory policy is a no-op
+
+#include <cstddef>
+#include <vector>
+
+class Numa{
+public:
+    enum Allocation_Policy{ First_Touch, Interleaved };
+
+private:
+    static Allocation_Policy allocation_policy;
+    static size_t interleave_threshold; // matrices and buffers smaller than this are never interleaved
+    static bool pinning;
+
+public:
+// ========================================================================================================================================== getters and setters
+    static size_t get_node_count(); // memory nodes of the machine, 1 without NUMA support
+    static const std::vector<std::vector<int>> &get_node_cpus(); // cores of every node usable by the process
+    static Allocation_Policy get_allocation_policy() { return allocation_policy; }
+    static void set_allocation_policy(Allocation_Policy policy) { allocation_policy = policy; } // not thread safe, meant to be set once at start up
+    static size_t get_interleave_threshold() { return interleave_threshold; }
+    static void set_interleave_threshold(size_t bytes) { interleave_threshold = bytes; }
+    static bool is_pinning() { return pinning; }
+    static void set_pinning(bool enabled) { pinning = enabled; } // affects the loops started afterwards and the executors created afterwards
+
+// ========================================================================================================================================== placement
+    static bool interleaves(size_t bytes); // true if the allocation policy spreads a matrix or buffer of this size over the nodes
+    static void place(void* address, size_t bytes); // applies the allocation policy to freshly allocated memory, before it is touched
+    static void set_thread_interleaving(bool enabled); // pages first touched by the calling thread are spread over the nodes, or placed by the default policy again
+    static int cpu_for(size_t index, size_t count); // core of the thread index out of count, -1 if the cores are unknown
+    static bool pin_thread(size_t index, size_t count); // pins the calling thread to cpu_for(index, count), false if it could not be pinned
+};
+
+#endif // _NUMA_H_
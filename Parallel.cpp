@@ -0,0 +1,78 @@
+#include "Parallel.h"
+#include "Numa.h"
+#include <thread>
+#include <vector>
+#include <exception>
+
+static size_t hardware_threads(){
+    size_t count = std::thread::hardware_concurrency();
+    return (count == 0) ? 1 : count;
+}
+
+size_t Parallel::thread_count{hardware_threads()};
+static thread_local bool serial_thread{false};
+
+// ========================================================================================================================================== getters and setters
+void Parallel::set_thread_count(size_t count){ // 0 restores the hardware concurrency
+    thread_count = (count == 0) ? hardware_threads() : count;
+}
+
+bool Parallel::is_serial_thread(){
+    return serial_thread;
+}
+
+void Parallel::set_serial_thread(bool serial){
+    serial_thread = serial;
+}
+
+// ========================================================================================================================================== parallel loops
+void Parallel::run_range(size_t begin, size_t end, size_t min_chunk, const std::function<void(size_t, size_t)> &body){ // the loop behind for_range
+    if(end <= begin)
+        return;
+    if(min_chunk == 0)
+        min_chunk = 1;
+
+    size_t length = end - begin;
+    size_t chunks = length / min_chunk;
+    if(chunks > thread_count)
+        chunks = thread_count;
+    if(serial_thread)
+        chunks = 1;
+    if(chunks <= 1){ // not worth spawning any thread
+        body(begin, end);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(chunks);
+    threads.reserve(chunks);
+    bool pinned = Numa::is_pinning(); // every chunk gets its own pinned thread, the calling thread keeps its affinity
+
+    size_t chunk_length = length / chunks;
+    size_t remainder = length % chunks;
+    size_t chunk_begin = begin;
+    for(size_t t{} ; t < chunks ; t++){
+        size_t chunk_end = chunk_begin + chunk_length + ((t < remainder) ? 1 : 0);
+        auto task = [&body, &errors, t, chunks, pinned, chunk_begin, chunk_end](){
+            try{
+                if(pinned)
+                    Numa::pin_thread(t, chunks);
+                body(chunk_begin, chunk_end);
+            }
+            catch(...){
+                errors[t] = std::current_exception();
+            }
+        };
+        if(t + 1 == chunks && !pinned)
+            task(); // the calling thread processes the last chunk itself
+        else
+            threads.emplace_back(task);
+        chunk_begin = chunk_end;
+    }
+
+    for(auto &thread : threads)
+        thread.join();
+    for(auto &error : errors)
+        if(error)
+            std::rethrow_exception(error);
+}
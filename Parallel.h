@@ -0,0 +1,35 @@
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+// Parallel provides the simple fork-join loop used by the heavier operations of the library
+// the range is split into contiguous chunks, every chunk is processed by a separate thread and the calling thread waits for all of them
+// the body always receives whole chunks, so results that depend only on the element index are independent of the thread count
+// with Numa pinning enabled, the thread of chunk t runs on the core Numa::cpu_for(t, chunks), so the same rows stay on the same node
+// a thread can be marked serial, its loops then run on the thread itself (the workers of Executor use it to avoid oversubscribing the cores)
+
+#include <cstddef>
+#include <functional>
+
+class Parallel{
+    static size_t thread_count;
+
+    static void run_range(size_t begin, size_t end, size_t min_chunk, const std::function<void(size_t, size_t)> &body); // the loop behind for_range
+
+public:
+// ========================================================================================================================================== getters and setters
+    static size_t get_thread_count() { return thread_count; } // maximal number of threads used by a single loop
+    static void set_thread_count(size_t count); // 0 restores the hardware concurrency
+    static bool is_serial_thread(); // true if the loops started by the calling thread run on it alone
+    static void set_serial_thread(bool serial); // marks the calling thread only
+
+// ========================================================================================================================================== parallel loops
+    template<typename Body>
+    static void for_range(size_t begin, size_t end, size_t min_chunk, const Body &body); // calls body(chunk_begin, chunk_end) for the chunks of [begin, end)
+};
+
+template<typename Body>
+void Parallel::for_range(size_t begin, size_t end, size_t min_chunk, const Body &body){ // calls body(chunk_begin, chunk_end) for the chunks of [begin, end)
+    run_range(begin, end, min_chunk, std::cref(body)); // a std::function holding a reference never allocates, unlike one holding a big lambda
+}
+
+#endif // _PARALLEL_H_
@@ -0,0 +1,117 @@
+#include "Preconditioner.h"
+#include <algorithm>
+#include <cstdint>
+
+static void validate_lengths(const Base_Vector &residual, const Base_Vector &result, size_t size){
+    if(residual.get_length() != size || result.get_length() != size){
+        std::cerr << "\nVector lengths do not match the size of the preconditioner... \n";
+        throw Base_Matrix();
+    }
+    if(residual.data() == result.data()){
+        std::cerr << "\nPreconditioner cannot be applied in place... \n";
+        throw Base_Matrix();
+    }
+}
+
+// ========================================================================================================================================== Jacobi_Preconditioner
+Jacobi_Preconditioner::Jacobi_Preconditioner(const Base_Matrix &matrix) : inverse_diagonal(matrix.get_rows()){
+    if(matrix.get_rows() != matrix.get_columns()){
+        std::cerr << "\nPreconditioner needs a square matrix... \n";
+        throw Base_Matrix();
+    }
+    for(size_t r{} ; r < inverse_diagonal.size() ; r++){
+        data_type diagonal = matrix[r].data()[r];
+        if(diagonal == 0){
+            std::cerr << "\nJacobi preconditioner needs a diagonal without zeros... \n";
+            throw Base_Matrix();
+        }
+        inverse_diagonal[r] = 1 / diagonal;
+    }
+}
+
+Jacobi_Preconditioner::Jacobi_Preconditioner(const Sparse_Matrix &matrix) : inverse_diagonal(matrix.get_rows()){
+    if(matrix.get_rows() != matrix.get_columns()){
+        std::cerr << "\nPreconditioner needs a square matrix... \n";
+        throw Base_Matrix();
+    }
+    for(size_t r{} ; r < inverse_diagonal.size() ; r++){
+        data_type diagonal = matrix.at(r, r);
+        if(diagonal == 0){
+            std::cerr << "\nJacobi preconditioner needs a diagonal without zeros... \n";
+            throw Base_Matrix();
+        }
+        inverse_diagonal[r] = 1 / diagonal;
+    }
+}
+
+void Jacobi_Preconditioner::apply(const Base_Vector &residual, Base_Vector &result) const{ // result = residual / diagonal
+    validate_lengths(residual, result, inverse_diagonal.size());
+    const data_type* in = residual.data();
+    data_type* out = result.data();
+    for(size_t i{} ; i < inverse_diagonal.size() ; i++)
+        out[i] = in[i] * inverse_diagonal[i];
+}
+
+// ========================================================================================================================================== ILU_Preconditioner
+ILU_Preconditioner::ILU_Preconditioner(const Sparse_Matrix &matrix)
+    : row_starts{matrix.get_row_starts()}, column_indices{matrix.get_column_indices()}, factors{matrix.get_values()}, diagonal_positions(matrix.get_rows()){
+    size_t n = matrix.get_rows();
+    if(n != matrix.get_columns()){
+        std::cerr << "\nPreconditioner needs a square matrix... \n";
+        throw Base_Matrix();
+    }
+    for(size_t r{} ; r < n ; r++){
+        auto first = column_indices.begin() + row_starts[r];
+        auto last = column_indices.begin() + row_starts[r + 1];
+        auto found = std::lower_bound(first, last, r);
+        if(found == last || *found != r || factors[found - column_indices.begin()] == 0){
+            std::cerr << "\nILU(0) needs every diagonal value stored and non zero... \n";
+            throw Base_Matrix();
+        }
+        diagonal_positions[r] = found - column_indices.begin();
+    }
+
+    std::vector<size_t> position_of_column(n, SIZE_MAX); // position of every column of the current row, SIZE_MAX outside of the pattern
+    for(size_t r{1} ; r < n ; r++){
+        for(size_t i{row_starts[r]} ; i < row_starts[r + 1] ; i++)
+            position_of_column[column_indices[i]] = i;
+        for(size_t i{row_starts[r]} ; i < diagonal_positions[r] ; i++){ // eliminates with every earlier row k, fill-in outside of the pattern is dropped
+            size_t k = column_indices[i];
+            data_type multiplier = factors[i] / factors[diagonal_positions[k]];
+            factors[i] = multiplier;
+            for(size_t j{diagonal_positions[k] + 1} ; j < row_starts[k + 1] ; j++){
+                size_t position = position_of_column[column_indices[j]];
+                if(position != SIZE_MAX)
+                    factors[position] -= multiplier * factors[j];
+            }
+        }
+        for(size_t i{row_starts[r]} ; i < row_starts[r + 1] ; i++)
+            position_of_column[column_indices[i]] = SIZE_MAX;
+        if(factors[diagonal_positions[r]] == 0){
+            std::cerr << "\nZero pivot in the incomplete LU factorization... \n";
+            throw Base_Matrix();
+        }
+    }
+}
+
+ILU_Preconditioner::ILU_Preconditioner(const Base_Matrix &matrix) : ILU_Preconditioner(Sparse_Matrix(matrix)){ // uses the non zero pattern of the dense matrix
+}
+
+void ILU_Preconditioner::apply(const Base_Vector &residual, Base_Vector &result) const{ // forward substitution with L, then backward substitution with U
+    size_t n = diagonal_positions.size();
+    validate_lengths(residual, result, n);
+    const data_type* in = residual.data();
+    data_type* out = result.data();
+    for(size_t r{} ; r < n ; r++){ // L * y = residual, y is stored in the result
+        data_type sum = in[r];
+        for(size_t i{row_starts[r]} ; i < diagonal_positions[r] ; i++)
+            sum -= factors[i] * out[column_indices[i]];
+        out[r] = sum;
+    }
+    for(size_t r{n} ; r-- > 0 ; ){ // U * result = y
+        data_type sum = out[r];
+        for(size_t i{diagonal_positions[r] + 1} ; i < row_starts[r + 1] ; i++)
+            sum -= factors[i] * out[column_indices[i]];
+        out[r] = sum / factors[diagonal_positions[r]];
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef _PRECONDITIONER_H_
+#define _PRECONDITIONER_H_
+
+// Preconditioner is the interface of the preconditioners accepted by the iterative solvers (see Krylov_Solver.h)
+// apply computes result = M^-1 * residual, where M approximates the system matrix and is much cheaper to invert
+// Jacobi_Preconditioner uses the diagonal of the matrix, ILU_Preconditioner the incomplete LU factorization with the sparsity pattern of the matrix (ILU(0))
+// both are built once and can be reused for any number of solves with the same matrix
+
+#include <vector>
+#include "Base_Matrix.h"
+#include "Sparse_Matrix.h"
+
+class Preconditioner{
+public:
+    virtual ~Preconditioner() = default;
+    virtual void apply(const Base_Vector &residual, Base_Vector &result) const = 0; // result = M^-1 * residual, result is never the residual itself
+    virtual size_t get_size() const = 0; // length of the vectors it applies to
+};
+
+class Jacobi_Preconditioner : public Preconditioner{
+    std::vector<data_type> inverse_diagonal;
+
+public:
+    Jacobi_Preconditioner(const Base_Matrix &matrix);
+    Jacobi_Preconditioner(const Sparse_Matrix &matrix);
+
+    virtual void apply(const Base_Vector &residual, Base_Vector &result) const; // result = residual / diagonal
+    virtual size_t get_size() const { return inverse_diagonal.size(); }
+};
+
+class ILU_Preconditioner : public Preconditioner{
+    std::vector<size_t> row_starts; // CSR pattern of the matrix, shared by both factors
+    std::vector<size_t> column_indices;
+    std::vector<data_type> factors; // strictly lower part holds L (with an implicit unit diagonal), the rest holds U
+    std::vector<size_t> diagonal_positions; // position of the diagonal value of every row
+
+public:
+    ILU_Preconditioner(const Sparse_Matrix &matrix); // the matrix has to be square with every diagonal value stored and non zero
+    ILU_Preconditioner(const Base_Matrix &matrix); // uses the non zero pattern of the dense matrix
+
+    virtual void apply(const Base_Vector &residual, Base_Vector &result) const; // forward substitution with L, then backward substitution with U
+    virtual size_t get_size() const { return diagonal_positions.size(); }
+};
+
+#endif // _PRECONDITIONER_H_
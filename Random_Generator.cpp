@@ -0,0 +1,129 @@
+#include "Random_Generator.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include <random>
+#include <cmath>
+
+static const uint32_t philox_multiplier_0{0xD2511F53};
+static const uint32_t philox_multiplier_1{0xCD9E8D57};
+static const uint32_t philox_weyl_0{0x9E3779B9};
+static const uint32_t philox_weyl_1{0xBB67AE85};
+static const size_t elements_per_chunk{1 << 14}; // smallest amount of work worth a separate thread
+
+static double to_unit_interval(uint32_t high, uint32_t low){ // 53 random bits mapped to [0, 1)
+    uint64_t bits = ((static_cast<uint64_t>(high) << 32) | low) >> 11;
+    return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+// ========================================================================================================================================== constructors
+Random_Generator::Random_Generator(uint64_t seed) : seed{seed}{ // default constructor
+}
+
+// ========================================================================================================================================== getters and setters
+uint64_t Random_Generator::random_seed(){ // non deterministic seed
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+// ========================================================================================================================================== single values
+std::array<uint32_t, 4> Random_Generator::block(uint64_t index, uint32_t stream) const{ // raw Philox4x32-10 output for the given counter
+    std::array<uint32_t, 4> counter{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), stream, 0};
+    uint32_t key_0 = static_cast<uint32_t>(seed);
+    uint32_t key_1 = static_cast<uint32_t>(seed >> 32);
+
+    for(int round{} ; round < 10 ; round++){
+        uint64_t product_0 = static_cast<uint64_t>(philox_multiplier_0) * counter[0];
+        uint64_t product_1 = static_cast<uint64_t>(philox_multiplier_1) * counter[2];
+        counter = {static_cast<uint32_t>(product_1 >> 32) ^ counter[1] ^ key_0, static_cast<uint32_t>(product_1),
+                   static_cast<uint32_t>(product_0 >> 32) ^ counter[3] ^ key_1, static_cast<uint32_t>(product_0)};
+        key_0 += philox_weyl_0;
+        key_1 += philox_weyl_1;
+    }
+    return counter;
+}
+
+data_type Random_Generator::uniform(uint64_t index, data_type lower_limit, data_type upper_limit) const{ // uniform value from [lower_limit, upper_limit)
+    auto bits = block(index);
+    return lower_limit + (upper_limit - lower_limit) * to_unit_interval(bits[0], bits[1]);
+}
+
+data_type Random_Generator::normal(uint64_t index, data_type mean, data_type standard_deviation) const{ // normal value, Box-Muller transform
+    auto bits = block(index);
+    double radius = std::sqrt(-2.0 * std::log(1.0 - to_unit_interval(bits[0], bits[1]))); // 1 - u lies in (0, 1], so the logarithm is finite
+    double angle = 6.283185307179586 * to_unit_interval(bits[2], bits[3]);
+    return mean + standard_deviation * radius * std::cos(angle);
+}
+
+int64_t Random_Generator::integer(uint64_t index, int64_t lower_limit, int64_t upper_limit) const{ // unbiased integer from [lower_limit, upper_limit]
+    if(upper_limit < lower_limit){
+        std::cerr << "\nUpper limit cannot be smaller than lower limit... \n";
+        throw Random_Generator();
+    }
+    uint64_t range = static_cast<uint64_t>(upper_limit) - static_cast<uint64_t>(lower_limit) + 1;
+    if(range == 0){ // the whole 64 bit range
+        auto bits = block(index);
+        return static_cast<int64_t>((static_cast<uint64_t>(bits[0]) << 32) | bits[1]);
+    }
+
+    uint64_t threshold = (0 - range) % range; // Lemire's multiply and reject, candidates below the threshold would introduce the bias
+    for(uint32_t attempt{} ; ; attempt++){
+        auto bits = block(index, attempt);
+        for(size_t i{} ; i < 4 ; i += 2){
+            uint64_t candidate = (static_cast<uint64_t>(bits[i]) << 32) | bits[i + 1];
+            unsigned __int128 product = static_cast<unsigned __int128>(candidate) * range;
+            if(static_cast<uint64_t>(product) >= threshold)
+                return static_cast<int64_t>(static_cast<uint64_t>(lower_limit) + static_cast<uint64_t>(product >> 64));
+        }
+    }
+}
+
+// ========================================================================================================================================== matrix filling
+void Random_Generator::fill_uniform(Base_Matrix &matrix, data_type lower_limit, data_type upper_limit) const{
+    MATRICES_TIMED_SCOPE(Random_Fill);
+    MATRICES_RECORD(Random_Fill, 0, matrix.get_rows() * matrix.get_columns() * sizeof(data_type));
+    if(upper_limit < lower_limit){
+        std::cerr << "\nUpper limit cannot be smaller than lower limit... \n";
+        throw Random_Generator();
+    }
+    size_t columns = matrix.get_columns();
+    Base_Vector* rows = matrix.get_ptr();
+    Parallel::for_range(0, matrix.get_rows(), elements_per_chunk / columns + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++){
+            data_type* row = rows[r].data();
+            for(size_t c{} ; c < columns ; c++)
+                row[c] = uniform(r * columns + c, lower_limit, upper_limit);
+        }
+    });
+}
+
+void Random_Generator::fill_normal(Base_Matrix &matrix, data_type mean, data_type standard_deviation) const{
+    MATRICES_TIMED_SCOPE(Random_Fill);
+    MATRICES_RECORD(Random_Fill, 0, matrix.get_rows() * matrix.get_columns() * sizeof(data_type));
+    size_t columns = matrix.get_columns();
+    Base_Vector* rows = matrix.get_ptr();
+    Parallel::for_range(0, matrix.get_rows(), elements_per_chunk / columns + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++){
+            data_type* row = rows[r].data();
+            for(size_t c{} ; c < columns ; c++)
+                row[c] = normal(r * columns + c, mean, standard_deviation);
+        }
+    });
+}
+
+void Random_Generator::fill_integer(Base_Matrix &matrix, int64_t lower_limit, int64_t upper_limit, data_type scale) const{ // fills with integer * scale
+    MATRICES_TIMED_SCOPE(Random_Fill);
+    MATRICES_RECORD(Random_Fill, 0, matrix.get_rows() * matrix.get_columns() * sizeof(data_type));
+    if(upper_limit < lower_limit){
+        std::cerr << "\nUpper limit cannot be smaller than lower limit... \n";
+        throw Random_Generator();
+    }
+    size_t columns = matrix.get_columns();
+    Base_Vector* rows = matrix.get_ptr();
+    Parallel::for_range(0, matrix.get_rows(), elements_per_chunk / columns + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++){
+            data_type* row = rows[r].data();
+            for(size_t c{} ; c < columns ; c++)
+                row[c] = integer(r * columns + c, lower_limit, upper_limit) * scale;
+        }
+    });
+}
@@ -0,0 +1,35 @@
+#ifndef _RANDOM_GENERATOR_H_
+#define _RANDOM_GENERATOR_H_
+
+// Random_Generator is a counter based generator (Philox4x32-10), every value is a pure function of the seed and the index of the element
+// there is no hidden state, so the generator is thread safe, it can be seeded explicitly and the same seed always gives the same matrix
+// matrices are filled in parallel, element (r, c) always uses the index r * columns + c, so results do not depend on the number of threads
+
+#include <array>
+#include <cstdint>
+#include "Base_Matrix.h"
+
+class Random_Generator{
+    uint64_t seed;
+
+public:
+// ========================================================================================================================================== constructors
+    explicit Random_Generator(uint64_t seed = Random_Generator::random_seed()); // default constructor, unseeded generators get a seed from std::random_device
+
+// ========================================================================================================================================== getters and setters
+    uint64_t get_seed() const { return seed; }
+    static uint64_t random_seed(); // non deterministic seed
+
+// ========================================================================================================================================== single values
+    std::array<uint32_t, 4> block(uint64_t index, uint32_t stream = 0) const; // raw Philox4x32-10 output for the given counter
+    data_type uniform(uint64_t index, data_type lower_limit = 0, data_type upper_limit = 1) const; // uniform value from [lower_limit, upper_limit)
+    data_type normal(uint64_t index, data_type mean = 0, data_type standard_deviation = 1) const; // normal value, Box-Muller transform
+    int64_t integer(uint64_t index, int64_t lower_limit, int64_t upper_limit) const; // unbiased integer from [lower_limit, upper_limit]
+
+// ========================================================================================================================================== matrix filling
+    void fill_uniform(Base_Matrix &matrix, data_type lower_limit = 0, data_type upper_limit = 1) const;
+    void fill_normal(Base_Matrix &matrix, data_type mean = 0, data_type standard_deviation = 1) const;
+    void fill_integer(Base_Matrix &matrix, int64_t lower_limit, int64_t upper_limit, data_type scale = 1) const; // fills with integer * scale
+};
+
+#endif // _RANDOM_GENERATOR_H_
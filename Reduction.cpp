@@ -0,0 +1,148 @@
+#include "Reduction.h"
+#include "Parallel.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+static const size_t block_size{4096}; // values of a single leaf block, fixed so that the result does not depend on the thread count
+static const size_t blocks_per_thread{4}; // smallest amount of work worth a separate thread
+static const size_t lanes{8}; // independent partial sums of the base case, they let the compiler vectorize the loop
+
+template<typename Term>
+static data_type pairwise(size_t first, size_t count, const Term &term){ // pairwise sum of term(first), ..., term(first + count - 1)
+    if(count <= 16 * lanes){
+        data_type partial[lanes]{};
+        size_t i{};
+        for( ; i + lanes <= count ; i += lanes)
+            for(size_t l{} ; l < lanes ; l++)
+                partial[l] += term(first + i + l);
+        for(size_t l{} ; i < count ; i++, l++)
+            partial[l] += term(first + i);
+        return ((partial[0] + partial[1]) + (partial[2] + partial[3])) + ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+    }
+    size_t half = count / 2;
+    return pairwise(first, half, term) + pairwise(first + half, count - half, term);
+}
+
+template<typename Term>
+static data_type blocked_sum(size_t count, bool parallel, std::vector<data_type> &partials, const Term &term){ // pairwise sums of the blocks, combined pairwise
+    size_t blocks = (count + block_size - 1) / block_size;
+    if(blocks <= 1)
+        return pairwise(0, count, term);
+    if(partials.size() < blocks) // grows only, a reused workspace does not allocate again
+        partials.resize(blocks);
+    auto body = [&](size_t first_block, size_t last_block){
+        for(size_t b{first_block} ; b < last_block ; b++){
+            size_t first = b * block_size;
+            partials[b] = pairwise(first, (count - first < block_size) ? count - first : block_size, term);
+        }
+    };
+    if(parallel)
+        Parallel::for_range(0, blocks, blocks_per_thread, body);
+    else
+        body(0, blocks);
+    return pairwise(0, blocks, [&partials](size_t b){ return partials[b]; });
+}
+
+template<typename Key>
+static size_t blocked_search(size_t count, bool parallel, std::vector<size_t> &winners, const Key &key){ // index of the first largest key, ties go to the smaller index
+    if(count == 0){
+        std::cerr << "\nCannot search an empty sequence... \n";
+        throw Reduction();
+    }
+    auto search = [&key](size_t first, size_t last){
+        size_t best = first;
+        for(size_t i{first + 1} ; i < last ; i++)
+            if(key(i) > key(best))
+                best = i;
+        return best;
+    };
+    size_t blocks = (count + block_size - 1) / block_size;
+    if(blocks <= 1)
+        return search(0, count);
+    if(winners.size() < blocks)
+        winners.resize(blocks);
+    auto body = [&](size_t first_block, size_t last_block){
+        for(size_t b{first_block} ; b < last_block ; b++)
+            winners[b] = search(b * block_size, (b + 1 == blocks) ? count : (b + 1) * block_size);
+    };
+    if(parallel)
+        Parallel::for_range(0, blocks, blocks_per_thread, body);
+    else
+        body(0, blocks);
+    size_t best = winners[0];
+    for(size_t b{1} ; b < blocks ; b++)
+        if(key(winners[b]) > key(best))
+            best = winners[b];
+    return best;
+}
+
+// ========================================================================================================================================== sums
+data_type Reduction::sum(const data_type* values, size_t count, bool parallel){ // sum of the values (static function)
+    std::vector<data_type> partials;
+    return blocked_sum(count, parallel, partials, [values](size_t i){ return values[i]; });
+}
+
+data_type Reduction::sum_of_absolutes(const data_type* values, size_t count, bool parallel){ // sum of |value| (static function)
+    std::vector<data_type> partials;
+    return blocked_sum(count, parallel, partials, [values](size_t i){ return std::fabs(values[i]); });
+}
+
+data_type Reduction::sum_of_squares(const data_type* values, size_t count, data_type scale, bool parallel){ // sum of (scale * value)^2 (static function)
+    Reduction_Workspace workspace;
+    return sum_of_squares(values, count, scale, workspace, parallel);
+}
+
+data_type Reduction::sum_of_squares(const data_type* values, size_t count, data_type scale, Reduction_Workspace &workspace, bool parallel){ // sum of (scale * value)^2 without allocating once the workspace is big enough (static function)
+    return blocked_sum(count, parallel, workspace.partials, [values, scale](size_t i){ data_type scaled = scale * values[i]; return scaled * scaled; });
+}
+
+data_type Reduction::dot(const data_type* left, const data_type* right, size_t count, bool parallel){ // sum of left * right (static function)
+    Reduction_Workspace workspace;
+    return dot(left, right, count, workspace, parallel);
+}
+
+data_type Reduction::dot(const data_type* left, const data_type* right, size_t count, Reduction_Workspace &workspace, bool parallel){ // sum of left * right without allocating once the workspace is big enough (static function)
+    return blocked_sum(count, parallel, workspace.partials, [left, right](size_t i){ return left[i] * right[i]; });
+}
+
+data_type Reduction::euclidean_norm(const data_type* values, size_t count, bool parallel){ // square root of the sum of squares, rescaled when it would overflow or underflow (static function)
+    Reduction_Workspace workspace;
+    return euclidean_norm(values, count, workspace, parallel);
+}
+
+data_type Reduction::euclidean_norm(const data_type* values, size_t count, Reduction_Workspace &workspace, bool parallel){ // euclidean norm without allocating once the workspace is big enough (static function)
+    data_type squares = sum_of_squares(values, count, 1, workspace, parallel);
+    if(std::isfinite(squares) && squares > 1e-280) // the common case needs a single pass
+        return std::sqrt(squares);
+    if(count == 0)
+        return 0;
+    data_type largest = std::fabs(values[index_of_max_absolute(values, count, workspace, parallel)]);
+    if(largest == 0 || !std::isfinite(largest))
+        return largest;
+    if(!std::isfinite(1 / largest)){ // subnormal values, 1 / largest overflows, an exact power of two brings them to the normal range instead
+        const data_type scale = std::ldexp(data_type(1), 600);
+        return std::sqrt(sum_of_squares(values, count, scale, workspace, parallel)) / scale;
+    }
+    return largest * std::sqrt(sum_of_squares(values, count, 1 / largest, workspace, parallel));
+}
+
+// ========================================================================================================================================== searches
+size_t Reduction::index_of_min(const data_type* values, size_t count, bool parallel){ // index of the first smallest value (static function)
+    std::vector<size_t> winners;
+    return blocked_search(count, parallel, winners, [values](size_t i){ return -values[i]; });
+}
+
+size_t Reduction::index_of_max(const data_type* values, size_t count, bool parallel){ // index of the first largest value (static function)
+    std::vector<size_t> winners;
+    return blocked_search(count, parallel, winners, [values](size_t i){ return values[i]; });
+}
+
+size_t Reduction::index_of_max_absolute(const data_type* values, size_t count, bool parallel){ // index of the first value with the largest |value| (static function)
+    Reduction_Workspace workspace;
+    return index_of_max_absolute(values, count, workspace, parallel);
+}
+
+size_t Reduction::index_of_max_absolute(const data_type* values, size_t count, Reduction_Workspace &workspace, bool parallel){ // index of the first value with the largest |value| without allocating once the workspace is big enough (static function)
+    return blocked_search(count, parallel, workspace.winners, [values](size_t i){ return std::fabs(values[i]); });
+}
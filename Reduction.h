@@ -0,0 +1,38 @@
+#ifndef _REDUCTION_H_
+#define _REDUCTION_H_
+
+// Reduction provides the summation and search kernels behind the reductions of Base_Vector and Base_Matrix
+// values are split into blocks of fixed size, every block is summed pairwise and the block sums are combined pairwise again
+// the blocks do not depend on the thread count, so the parallel and the serial kernels give bit identical results
+// pairwise summation keeps the rounding error at O(log n * u) instead of the O(n * u) of a simple loop
+
+#include <cstddef>
+#include <vector>
+
+typedef double data_type;
+
+struct Reduction_Workspace{ // partial results of the blocks, owned by the caller so that repeated reductions do not allocate
+    std::vector<data_type> partials;
+    std::vector<size_t> winners;
+};
+
+class Reduction{
+public:
+// ========================================================================================================================================== sums
+    static data_type sum(const data_type* values, size_t count, bool parallel = true); // sum of the values
+    static data_type sum_of_absolutes(const data_type* values, size_t count, bool parallel = true); // sum of |value|
+    static data_type sum_of_squares(const data_type* values, size_t count, data_type scale = 1, bool parallel = true); // sum of (scale * value)^2
+    static data_type sum_of_squares(const data_type* values, size_t count, data_type scale, Reduction_Workspace &workspace, bool parallel = true); // sum of (scale * value)^2 without allocating once the workspace is big enough
+    static data_type dot(const data_type* left, const data_type* right, size_t count, bool parallel = true); // sum of left * right
+    static data_type dot(const data_type* left, const data_type* right, size_t count, Reduction_Workspace &workspace, bool parallel = true); // sum of left * right without allocating once the workspace is big enough
+    static data_type euclidean_norm(const data_type* values, size_t count, bool parallel = true); // square root of the sum of squares, rescaled when it would overflow or underflow
+    static data_type euclidean_norm(const data_type* values, size_t count, Reduction_Workspace &workspace, bool parallel = true); // euclidean norm without allocating once the workspace is big enough
+
+// ========================================================================================================================================== searches
+    static size_t index_of_min(const data_type* values, size_t count, bool parallel = true); // index of the first smallest value
+    static size_t index_of_max(const data_type* values, size_t count, bool parallel = true); // index of the first largest value
+    static size_t index_of_max_absolute(const data_type* values, size_t count, bool parallel = true); // index of the first value with the largest |value|
+    static size_t index_of_max_absolute(const data_type* values, size_t count, Reduction_Workspace &workspace, bool parallel = true); // same without allocating once the workspace is big enough
+};
+
+#endif // _REDUCTION_H_
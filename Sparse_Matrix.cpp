@@ -0,0 +1,100 @@
+#include "Sparse_Matrix.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+static const size_t non_zeros_per_chunk{1 << 15}; // smallest amount of work worth a separate thread
+
+// ========================================================================================================================================== constructors
+Sparse_Matrix::Sparse_Matrix(size_t columns, size_t rows) : columns{columns}, rows{rows}, row_starts(rows + 1, 0){ // matrix of zeros
+    if(columns < 1 || rows < 1){
+        std::cerr << "\nDimensions cannot be smaller than 1... \n";
+        throw Sparse_Matrix();
+    }
+}
+
+Sparse_Matrix::Sparse_Matrix(const Base_Matrix &dense, data_type drop_tolerance) : columns{dense.get_columns()}, rows{dense.get_rows()}, row_starts(rows + 1, 0){ // keeps the values with |value| > drop_tolerance
+    for(size_t r{} ; r < rows ; r++){
+        const data_type* row = dense[r].data();
+        for(size_t c{} ; c < columns ; c++){
+            if(std::fabs(row[c]) > drop_tolerance){
+                column_indices.push_back(c);
+                values.push_back(row[c]);
+            }
+        }
+        row_starts[r + 1] = values.size();
+    }
+}
+
+Sparse_Matrix Sparse_Matrix::from_entries(size_t columns, size_t rows, std::vector<Entry> entries){ // entries in any order, duplicates are summed (static function)
+    Sparse_Matrix matrix(columns, rows);
+    for(const Entry &entry : entries){
+        if(entry.row >= rows || entry.column >= columns){
+            std::cerr << "\nEntry lies outside of the matrix... \n";
+            throw Sparse_Matrix();
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &left, const Entry &right){
+        return (left.row != right.row) ? left.row < right.row : left.column < right.column;
+    });
+    matrix.column_indices.reserve(entries.size());
+    matrix.values.reserve(entries.size());
+    for(size_t i{} ; i < entries.size() ; i++){
+        if(i > 0 && entries[i].row == entries[i - 1].row && entries[i].column == entries[i - 1].column)
+            matrix.values.back() += entries[i].value;
+        else{
+            matrix.column_indices.push_back(entries[i].column);
+            matrix.values.push_back(entries[i].value);
+            matrix.row_starts[entries[i].row + 1] = matrix.values.size();
+        }
+    }
+    for(size_t r{1} ; r <= rows ; r++) // empty rows end where the previous row ended
+        matrix.row_starts[r] = std::max(matrix.row_starts[r], matrix.row_starts[r - 1]);
+    return matrix;
+}
+
+// ========================================================================================================================================== getters
+data_type Sparse_Matrix::at(size_t row, size_t column) const{ // value at the given position, zero if it is not stored
+    if(row >= rows || column >= columns){
+        std::cerr << "\nIndex out of range... \n";
+        throw Sparse_Matrix();
+    }
+    auto first = column_indices.begin() + row_starts[row];
+    auto last = column_indices.begin() + row_starts[row + 1];
+    auto found = std::lower_bound(first, last, column);
+    return (found != last && *found == column) ? values[found - column_indices.begin()] : 0;
+}
+
+// ========================================================================================================================================== operations
+void Sparse_Matrix::multiply(const Base_Vector &input, Base_Vector &output) const{ // output = this * input, parallel over rows
+    MATRICES_RECORD(Multiply, 2 * values.size(), (2 * values.size() + input.get_length() + output.get_length()) * sizeof(data_type));
+    if(input.get_length() != columns || output.get_length() != rows){
+        std::cerr << "\nVector lengths do not match the dimensions of the sparse matrix... \n";
+        throw Sparse_Matrix();
+    }
+    if(input.data() == output.data()){
+        std::cerr << "\nResult of the multiplication cannot be its operand... \n";
+        throw Sparse_Matrix();
+    }
+    const data_type* in = input.data();
+    data_type* out = output.data();
+    Parallel::for_range(0, rows, non_zeros_per_chunk / (values.size() / rows + 1) + 1, [&](size_t first_row, size_t last_row){
+        for(size_t r{first_row} ; r < last_row ; r++){
+            data_type sum{};
+            for(size_t i{row_starts[r]} ; i < row_starts[r + 1] ; i++)
+                sum += values[i] * in[column_indices[i]];
+            out[r] = sum;
+        }
+    });
+}
+
+Base_Matrix Sparse_Matrix::to_dense() const{ // dense copy
+    Base_Matrix dense(columns, rows, 0);
+    for(size_t r{} ; r < rows ; r++){
+        data_type* row = dense[r].data();
+        for(size_t i{row_starts[r]} ; i < row_starts[r + 1] ; i++)
+            row[column_indices[i]] = values[i];
+    }
+    return dense;
+}
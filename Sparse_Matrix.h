@@ -0,0 +1,45 @@
+#ifndef _SPARSE_MATRIX_H_
+#define _SPARSE_MATRIX_H_
+
+// Sparse_Matrix stores only the non zero values, in the compressed sparse row (CSR) format
+// row_starts[r] is the position of the first value of the row r in column_indices and values, row_starts[rows] is the number of non zero values
+// the column indices are sorted inside every row, so single values can be found by binary search
+// Sparse_Matrix is meant for the iterative solvers (see Krylov_Solver.h), it provides the matrix-vector product and the conversions from and to Base_Matrix
+
+#include <vector>
+#include "Base_Matrix.h"
+
+class Sparse_Matrix{
+    size_t columns;
+    size_t rows;
+    std::vector<size_t> row_starts;
+    std::vector<size_t> column_indices;
+    std::vector<data_type> values;
+
+public:
+    struct Entry{
+        size_t row;
+        size_t column;
+        data_type value;
+    };
+
+// ========================================================================================================================================== constructors
+    Sparse_Matrix(size_t columns = 1, size_t rows = 1); // matrix of zeros
+    explicit Sparse_Matrix(const Base_Matrix &dense, data_type drop_tolerance = 0); // keeps the values with |value| > drop_tolerance
+    static Sparse_Matrix from_entries(size_t columns, size_t rows, std::vector<Entry> entries); // entries in any order, duplicates are summed (static function)
+
+// ========================================================================================================================================== getters
+    size_t get_columns() const { return columns; }
+    size_t get_rows() const { return rows; }
+    size_t get_non_zeros() const { return values.size(); }
+    const std::vector<size_t> &get_row_starts() const { return row_starts; }
+    const std::vector<size_t> &get_column_indices() const { return column_indices; }
+    const std::vector<data_type> &get_values() const { return values; }
+    data_type at(size_t row, size_t column) const; // value at the given position, zero if it is not stored
+
+// ========================================================================================================================================== operations
+    void multiply(const Base_Vector &input, Base_Vector &output) const; // output = this * input, parallel over rows
+    Base_Matrix to_dense() const; // dense copy
+};
+
+#endif // _SPARSE_MATRIX_H_
@@ -0,0 +1,139 @@
+#include "Strassen.h"
+#include "Parallel.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+static size_t padded_size(size_t n, size_t cutoff){ // smallest size >= n that can be halved until it is not bigger than the cutoff
+    size_t levels{};
+    while(((n + (size_t{1} << levels) - 1) >> levels) > cutoff)
+        levels++;
+    size_t base = (n + (size_t{1} << levels) - 1) >> levels;
+    return base << levels;
+}
+
+static size_t recursion_size(size_t n, size_t cutoff){ // values needed by the recursion below an n x n product
+    if(n <= cutoff)
+        return 0;
+    size_t h = n / 2;
+    return 2 * h * h + recursion_size(h, cutoff); // the two temporaries X and Y, then the workspace of the products, which run one after another
+}
+
+static const size_t values_per_chunk{1 << 16}; // values added by a single thread at least
+
+static void add(const data_type* x, size_t ldx, const data_type* y, size_t ldy, data_type* z, size_t ldz, size_t h, data_type sign){ // z = x + sign * y, z may be x or y
+    Parallel::for_range(0, h, values_per_chunk / h + 1, [&](size_t first_row, size_t last_row){
+        for(size_t i{first_row} ; i < last_row ; i++){
+            const data_type* x_row = x + i * ldx;
+            const data_type* y_row = y + i * ldy;
+            data_type* z_row = z + i * ldz;
+            for(size_t j{} ; j < h ; j++)
+                z_row[j] = x_row[j] + sign * y_row[j];
+        }
+    });
+}
+
+static void base_multiply(const data_type* a, size_t lda, const data_type* b, size_t ldb, data_type* c, size_t ldc, size_t n){ // c = a * b, cache blocked, parallel over rows
+    const size_t block{64};
+    Parallel::for_range(0, n, values_per_chunk / (n * n / block + 1) + 1, [&](size_t first_row, size_t last_row){
+        for(size_t i{first_row} ; i < last_row ; i++)
+            std::memset(c + i * ldc, 0, n * sizeof(data_type));
+        for(size_t kk{} ; kk < n ; kk += block){
+            size_t k_end = (kk + block < n) ? kk + block : n;
+            for(size_t i{first_row} ; i < last_row ; i++){
+                data_type* c_row = c + i * ldc;
+                for(size_t k{kk} ; k < k_end ; k++){
+                    data_type factor = a[i * lda + k];
+                    const data_type* b_row = b + k * ldb;
+                    for(size_t j{} ; j < n ; j++)
+                        c_row[j] += factor * b_row[j];
+                }
+            }
+        }
+    });
+}
+
+static void recurse(const data_type* a, size_t lda, const data_type* b, size_t ldb, data_type* c, size_t ldc, size_t n, size_t cutoff, data_type* workspace){
+    if(n <= cutoff){
+        base_multiply(a, lda, b, ldb, c, ldc, n);
+        return;
+    }
+    size_t h = n / 2;
+    const data_type *a11{a}, *a12{a + h}, *a21{a + h * lda}, *a22{a + h * lda + h};
+    const data_type *b11{b}, *b12{b + h}, *b21{b + h * ldb}, *b22{b + h * ldb + h};
+    data_type *c11{c}, *c12{c + h}, *c21{c + h * ldc}, *c22{c + h * ldc + h};
+    data_type *x{workspace}, *y{workspace + h * h};
+    data_type* sub_workspace = y + h * h;
+
+    // schedule of Boyer, Dumas, Pernet and Zhou: the products go to the quadrants of C, X and Y are the only temporaries
+    add(a11, lda, a21, lda, x, h, h, -1); // X = S3 = A11 - A21
+    add(b22, ldb, b12, ldb, y, h, h, -1); // Y = T3 = B22 - B12
+    recurse(x, h, y, h, c21, ldc, h, cutoff, sub_workspace); // C21 = P7 = S3 * T3
+    add(a21, lda, a22, lda, x, h, h, 1); // X = S1 = A21 + A22
+    add(b12, ldb, b11, ldb, y, h, h, -1); // Y = T1 = B12 - B11
+    recurse(x, h, y, h, c22, ldc, h, cutoff, sub_workspace); // C22 = P5 = S1 * T1
+    add(x, h, a11, lda, x, h, h, -1); // X = S2 = S1 - A11
+    add(b22, ldb, y, h, y, h, h, -1); // Y = T2 = B22 - T1
+    recurse(x, h, y, h, c12, ldc, h, cutoff, sub_workspace); // C12 = P6 = S2 * T2
+    add(a12, lda, x, h, x, h, h, -1); // X = S4 = A12 - S2
+    recurse(x, h, b22, ldb, c11, ldc, h, cutoff, sub_workspace); // C11 = P3 = S4 * B22
+    recurse(a11, lda, b11, ldb, x, h, h, cutoff, sub_workspace); // X = P1 = A11 * B11
+    add(x, h, c12, ldc, c12, ldc, h, 1); // C12 = U2 = P1 + P6
+    add(c12, ldc, c21, ldc, c21, ldc, h, 1); // C21 = U3 = U2 + P7
+    add(c12, ldc, c22, ldc, c12, ldc, h, 1); // C12 = U4 = U2 + P5
+    add(c21, ldc, c22, ldc, c22, ldc, h, 1); // C22 = U3 + P5
+    add(c12, ldc, c11, ldc, c12, ldc, h, 1); // C12 = U4 + P3
+    add(y, h, b21, ldb, y, h, h, -1); // Y = T4 = T2 - B21
+    recurse(a22, lda, y, h, c11, ldc, h, cutoff, sub_workspace); // C11 = P4 = A22 * T4
+    add(c21, ldc, c11, ldc, c21, ldc, h, -1); // C21 = U3 - P4
+    recurse(a12, lda, b21, ldb, c11, ldc, h, cutoff, sub_workspace); // C11 = P2 = A12 * B21
+    add(x, h, c11, ldc, c11, ldc, h, 1); // C11 = P1 + P2
+}
+
+size_t Strassen::workspace_size(size_t n, size_t cutoff){ // number of values of the arena needed for an n x n product (static function)
+    size_t m = padded_size(n, cutoff);
+    return 3 * m * m + recursion_size(m, cutoff); // packed operands and result, then the recursion
+}
+
+static thread_local std::unique_ptr<data_type[]> arena; // reused by every product computed on this thread, never value initialized
+static thread_local size_t arena_size{0};
+size_t Strassen::workspace_limit{SIZE_MAX};
+
+void Strassen::release_workspace(){ // frees the arena of the calling thread (static function)
+    arena.reset();
+    arena_size = 0;
+}
+
+void Strassen::multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result, size_t cutoff){ // result = left * right (static function)
+    size_t n = left_matrice.get_rows();
+    if(left_matrice.get_columns() != n || right_matrice.get_rows() != n || right_matrice.get_columns() != n || result.get_rows() != n || result.get_columns() != n){
+        std::cerr << "\nStrassen multiplication needs square matrices of the same size... \n";
+        throw Base_Matrix();
+    }
+    if(cutoff < 1)
+        cutoff = 1;
+
+    size_t needed = workspace_size(n, cutoff);
+    if(arena_size < needed){ // grows only, the packing below writes every value that is read
+        arena.reset();
+        arena.reset(new data_type[needed]);
+        arena_size = needed;
+    }
+
+    size_t m = padded_size(n, cutoff);
+    data_type* a = arena.get();
+    data_type* b = a + m * m;
+    data_type* c = b + m * m;
+    std::memset(a, 0, 2 * m * m * sizeof(data_type)); // zero padding
+    for(size_t r{} ; r < n ; r++){
+        std::memcpy(a + r * m, left_matrice[r].data(), n * sizeof(data_type));
+        std::memcpy(b + r * m, right_matrice[r].data(), n * sizeof(data_type));
+    }
+
+    recurse(a, m, b, m, c, m, m, cutoff, c + m * m);
+
+    for(size_t r{} ; r < n ; r++)
+        std::memcpy(result[r].data(), c + r * m, n * sizeof(data_type));
+    if(arena_size > workspace_limit) // opt in, by default the arena stays for the next product
+        release_workspace();
+}
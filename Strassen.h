@@ -0,0 +1,29 @@
+#ifndef _STRASSEN_H_
+#define _STRASSEN_H_
+
+// Strassen multiplies square matrices with the Strassen-Winograd algorithm (7 half size products and 15 additions per level)
+// the operands are packed into zero padded contiguous buffers, the recursion stops at the cutoff and falls through to a cache blocked kernel
+// the products are scheduled as Boyer, Dumas, Pernet and Zhou do: they are written into the quadrants of the result and every level needs
+// only two half size temporaries, the whole recursion 2/3 n^2 values, the arena holds about 3.7 n^2 values including the packed operands
+// all the temporaries come from a single workspace arena owned by the calling thread, so repeated products of the same size do not allocate
+// the arena is kept by default, release_workspace frees it on demand, a workspace limit makes every product free an arena bigger than the limit
+// the products run one after another, the base kernel and the additions are parallel
+//
+// accuracy: the error bound is normwise, |C - C'| <= c * n^log2(12) * u * |A| * |B|, instead of the elementwise bound of the standard product
+// in practice every level of recursion loses a few bits, and small elements of the result may have a large relative error
+// it should be used only when the matrices are large (thousands of rows), well scaled and the normwise error is acceptable
+
+#include "Base_Matrix.h"
+
+class Strassen{
+    static size_t workspace_limit; // values of the largest arena kept between the products
+
+public:
+    static void multiply(const Base_Matrix &left_matrice, const Base_Matrix &right_matrice, Base_Matrix &result, size_t cutoff); // result = left * right (static function)
+    static size_t workspace_size(size_t n, size_t cutoff); // number of values of the arena needed for an n x n product (static function)
+    static size_t get_workspace_limit() { return workspace_limit; }
+    static void set_workspace_limit(size_t values) { workspace_limit = values; } // default SIZE_MAX, the arena is never freed after a product
+    static void release_workspace(); // frees the arena of the calling thread (static function)
+};
+
+#endif // _STRASSEN_H_
@@ -0,0 +1,136 @@
+#include "Task_Graph.h"
+#include <iostream>
+
+// ========================================================================================================================================== constructors
+Task_Graph::Task_Graph(Executor &executor) : state{std::make_shared<State>()}, started{false} {
+    state->executor = &executor;
+    state->unfinished = 0;
+}
+
+// ========================================================================================================================================== getters
+std::shared_future<void> Task_Graph::get_future(size_t task) const{ // becomes ready when the task finished
+    if(task >= state->nodes.size()){
+        std::cerr << "\nTask index out of range! \n";
+        throw Task_Graph();
+    }
+    return state->nodes[task].future;
+}
+
+// ========================================================================================================================================== building and running
+size_t Task_Graph::add(std::function<void()> task, const std::vector<size_t> &dependencies, bool small){ // returns the index of the task
+    if(started){
+        std::cerr << "\nCannot add a task to a graph already running! \n";
+        throw Task_Graph();
+    }
+    if(!task){
+        std::cerr << "\nThe task is empty! \n";
+        throw Task_Graph();
+    }
+    size_t index = state->nodes.size();
+    for(size_t dependency : dependencies)
+        if(dependency >= index){
+            std::cerr << "\nA task can only depend on the tasks added before it! \n";
+            throw Task_Graph();
+        }
+
+    state->nodes.emplace_back();
+    Node &node = state->nodes.back();
+    node.task = std::move(task);
+    node.waiting = dependencies.size();
+    node.small = small;
+    node.future = node.done.get_future().share();
+    for(size_t dependency : dependencies)
+        state->nodes[dependency].dependents.push_back(index);
+    return index;
+}
+
+std::future<void> Task_Graph::run(){ // starts the tasks without dependencies, the future becomes ready when all tasks finished and rethrows the first exception
+    if(started){
+        std::cerr << "\nThe graph can run only once! \n";
+        throw Task_Graph();
+    }
+    started = true;
+    std::future<void> future = state->done.get_future();
+    state->unfinished = state->nodes.size();
+    if(state->nodes.empty()){
+        state->done.set_value();
+        return future;
+    }
+
+    std::vector<size_t> ready;
+    for(size_t t{} ; t < state->nodes.size() ; t++)
+        if(state->nodes[t].waiting == 0)
+            ready.push_back(t);
+    dispatch(state, ready);
+    return future;
+}
+
+void Task_Graph::dispatch(const std::shared_ptr<State> &state, const std::vector<size_t> &ready){ // posts the ready tasks, batching the small ones
+    std::vector<size_t> small;
+    for(size_t task : ready){
+        if(state->nodes[task].small){
+            small.push_back(task);
+            continue;
+        }
+        state->executor->post([state, task](){
+            std::vector<size_t> next;
+            execute(state, task, next);
+            dispatch(state, next);
+        });
+    }
+    if(small.empty())
+        return;
+
+    size_t workers = state->executor->get_thread_count();
+    size_t batch_size = (small.size() + workers - 1) / workers;
+    for(size_t first{} ; first < small.size() ; first += batch_size){
+        size_t last = (first + batch_size < small.size()) ? first + batch_size : small.size();
+        std::vector<size_t> batch(small.begin() + first, small.begin() + last);
+        state->executor->post([state, batch](){
+            std::vector<size_t> next;
+            for(size_t task : batch)
+                execute(state, task, next);
+            dispatch(state, next);
+        });
+    }
+}
+
+void Task_Graph::execute(const std::shared_ptr<State> &state, size_t task, std::vector<size_t> &ready){ // runs the task and collects the dependents becoming ready
+    Node &node = state->nodes[task];
+    std::exception_ptr error = node.error; // written before the dependency count reached zero, under the mutex
+    if(!error){
+        try{
+            node.task();
+        }
+        catch(...){
+            error = std::current_exception();
+        }
+    }
+    node.task = nullptr; // releases the captures
+
+    bool finished{false};
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        for(size_t dependent : node.dependents){
+            Node &next = state->nodes[dependent];
+            if(error && !next.error)
+                next.error = error;
+            if(--next.waiting == 0)
+                ready.push_back(dependent);
+        }
+        if(error && !state->first_error)
+            state->first_error = error;
+        finished = (--state->unfinished == 0);
+    }
+
+    if(error)
+        node.done.set_exception(error);
+    else
+        node.done.set_value();
+    if(finished){
+        if(state->first_error)
+            state->done.set_exception(state->first_error);
+        else
+            state->done.set_value();
+    }
+}
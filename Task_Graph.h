@@ -0,0 +1,58 @@
+#ifndef _TASK_GRAPH_H_
+#define _TASK_GRAPH_H_
+
+// Task_Graph runs a set of operations on an Executor, every task starts as soon as all its dependencies finished
+// a task can only depend on tasks added before it, so the graph never has a cycle
+// tasks marked small are batched: the small tasks becoming ready together are split into one job per worker instead of one job each
+// the results are passed through the captures of the tasks (an operand written by a task may be read by the tasks depending on it)
+// if a task throws, the tasks depending on it do not run and their futures rethrow the same exception, the other tasks still run
+// the graph can run only once, the tasks keep running when the Task_Graph object is destroyed before they finished
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Executor.h"
+
+class Task_Graph{
+    struct Node{
+        std::function<void()> task;
+        std::vector<size_t> dependents;
+        size_t waiting; // dependencies not finished yet
+        bool small;
+        std::exception_ptr error; // exception of a failed dependency, the task is skipped
+        std::promise<void> done;
+        std::shared_future<void> future;
+    };
+
+    struct State{
+        Executor* executor;
+        std::vector<Node> nodes;
+        std::mutex mutex;
+        size_t unfinished;
+        std::exception_ptr first_error;
+        std::promise<void> done;
+    };
+
+    std::shared_ptr<State> state;
+    bool started;
+
+    static void dispatch(const std::shared_ptr<State> &state, const std::vector<size_t> &ready); // posts the ready tasks, batching the small ones
+    static void execute(const std::shared_ptr<State> &state, size_t task, std::vector<size_t> &ready); // runs the task and collects the dependents becoming ready
+
+public:
+// ========================================================================================================================================== constructors
+    explicit Task_Graph(Executor &executor = Executor::shared());
+
+// ========================================================================================================================================== getters
+    size_t get_size() const { return state->nodes.size(); }
+    std::shared_future<void> get_future(size_t task) const; // becomes ready when the task finished
+
+// ========================================================================================================================================== building and running
+    size_t add(std::function<void()> task, const std::vector<size_t> &dependencies = {}, bool small = false); // returns the index of the task
+    std::future<void> run(); // starts the tasks without dependencies, the future becomes ready when all tasks finished and rethrows the first exception
+};
+
+#endif // _TASK_GRAPH_H_
@@ -0,0 +1,255 @@
+#include "Tiled_Matrix.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <utility>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+
+struct Tiled_Header{ // on disk header of the tiled format, exactly 64 bytes
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t columns;
+    uint64_t rows;
+    uint64_t tile_size;
+    uint64_t reserved[3];
+};
+static_assert(sizeof(Tiled_Header) == 64, "Tiled_Header must stay 64 bytes long");
+
+static const char tiled_magic[8]{'T', 'I', 'L', 'E', 'D', 'M', 'A', 'T'};
+static const uint32_t tiled_version{1};
+static const size_t max_prefetched_pairs{8};
+static const size_t resident_tiles_base{3}; // result tile and the pair being multiplied, every prefetched pair adds 2 tiles
+static const size_t min_budget_tiles{resident_tiles_base + 2}; // at least one prefetched pair
+
+static bool read_fully(int descriptor, void* destination, size_t length, off_t offset){
+    for(size_t done{} ; done < length ; ){
+        ssize_t count = pread(descriptor, static_cast<char*>(destination) + done, length - done, offset + done);
+        if(count <= 0)
+            return false;
+        done += count;
+    }
+    return true;
+}
+
+static bool write_fully(int descriptor, const void* source, size_t length, off_t offset){
+    for(size_t done{} ; done < length ; ){
+        ssize_t count = pwrite(descriptor, static_cast<const char*>(source) + done, length - done, offset + done);
+        if(count <= 0)
+            return false;
+        done += count;
+    }
+    return true;
+}
+
+// ========================================================================================================================================== constructors and destructor
+Tiled_Matrix::Tiled_Matrix(const std::string &path, size_t columns, size_t rows, size_t tile_size) : path{path}, descriptor{-1}, columns{columns}, rows{rows}, tile_size{tile_size}{ // creates a new zero filled file
+    if(columns < 1 || rows < 1 || tile_size < 1){
+        std::cerr << "\nDimensions and tile size cannot be smaller than 1... \n";
+        throw Matrix();
+    }
+    descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(descriptor < 0){
+        std::cerr << "\nCannot create the tiled matrix file... \n";
+        throw Matrix();
+    }
+    Tiled_Header header{};
+    std::memcpy(header.magic, tiled_magic, sizeof(tiled_magic));
+    header.version = tiled_version;
+    header.header_size = sizeof(Tiled_Header);
+    header.columns = columns;
+    header.rows = rows;
+    header.tile_size = tile_size;
+    off_t file_length = tile_offset(get_tile_rows(), 0); // end of the last tile
+    if(!write_fully(descriptor, &header, sizeof(header), 0) || ftruncate(descriptor, file_length) != 0){ // truncation leaves a sparse, zero filled file
+        close(descriptor);
+        std::cerr << "\nCannot create the tiled matrix file... \n";
+        throw Matrix();
+    }
+}
+
+Tiled_Matrix::Tiled_Matrix(const std::string &path) : path{path}, descriptor{-1}, columns{0}, rows{0}, tile_size{0}{ // opens an existing file
+    descriptor = open(path.c_str(), O_RDWR);
+    if(descriptor < 0){
+        std::cerr << "\nCannot open the tiled matrix file... \n";
+        throw Matrix();
+    }
+    Tiled_Header header{};
+    if(!read_fully(descriptor, &header, sizeof(header), 0) || std::memcmp(header.magic, tiled_magic, sizeof(tiled_magic)) != 0
+        || header.version != tiled_version || header.header_size != sizeof(Tiled_Header) || header.columns == 0 || header.rows == 0 || header.tile_size == 0){
+        close(descriptor);
+        std::cerr << "\nFile is not a valid tiled matrix of this version... \n";
+        throw Matrix();
+    }
+    columns = header.columns;
+    rows = header.rows;
+    tile_size = header.tile_size;
+}
+
+Tiled_Matrix::Tiled_Matrix(Tiled_Matrix &&source) : path{std::move(source.path)}, descriptor{source.descriptor}, columns{source.columns}, rows{source.rows}, tile_size{source.tile_size}{ // move constructor
+    source.descriptor = -1;
+}
+
+Tiled_Matrix::~Tiled_Matrix(){
+    if(descriptor >= 0)
+        close(descriptor);
+}
+
+size_t Tiled_Matrix::tile_offset(size_t tile_row, size_t tile_column) const{ // byte offset of the tile in the file
+    return sizeof(Tiled_Header) + (tile_row * get_tile_columns() + tile_column) * tile_size * tile_size * sizeof(data_type);
+}
+
+// ========================================================================================================================================== tile access
+Matrix Tiled_Matrix::load_tile(size_t tile_row, size_t tile_column) const{ // reads the tile from the file
+    if(tile_row >= get_tile_rows() || tile_column >= get_tile_columns()){
+        std::cerr << "\nTile index out of bounds... \n";
+        throw Matrix();
+    }
+    size_t tile_columns = std::min(tile_size, columns - tile_column * tile_size);
+    size_t tile_rows = std::min(tile_size, rows - tile_row * tile_size);
+    Matrix tile(tile_columns, tile_rows);
+    load_tile(tile_row, tile_column, tile);
+    return tile;
+}
+
+void Tiled_Matrix::load_tile(size_t tile_row, size_t tile_column, Base_Matrix &tile) const{ // reads the tile into existing storage of the right size
+    if(tile_row >= get_tile_rows() || tile_column >= get_tile_columns()){
+        std::cerr << "\nTile index out of bounds... \n";
+        throw Matrix();
+    }
+    if(tile.get_columns() != std::min(tile_size, columns - tile_column * tile_size) || tile.get_rows() != std::min(tile_size, rows - tile_row * tile_size)){
+        std::cerr << "\nTile has invalid dimensions... \n";
+        throw Matrix();
+    }
+    size_t offset = tile_offset(tile_row, tile_column);
+    for(size_t r{} ; r < tile.get_rows() ; r++){
+        if(!read_fully(descriptor, tile[r].data(), tile.get_columns() * sizeof(data_type), offset + r * tile_size * sizeof(data_type))){
+            std::cerr << "\nReading the tile from the file failed... \n";
+            throw Matrix();
+        }
+    }
+}
+
+void Tiled_Matrix::store_tile(size_t tile_row, size_t tile_column, const Base_Matrix &tile){ // writes the tile to the file
+    if(tile_row >= get_tile_rows() || tile_column >= get_tile_columns()){
+        std::cerr << "\nTile index out of bounds... \n";
+        throw Matrix();
+    }
+    if(tile.get_columns() != std::min(tile_size, columns - tile_column * tile_size) || tile.get_rows() != std::min(tile_size, rows - tile_row * tile_size)){
+        std::cerr << "\nTile has invalid dimensions... \n";
+        throw Matrix();
+    }
+    size_t offset = tile_offset(tile_row, tile_column);
+    for(size_t r{} ; r < tile.get_rows() ; r++){
+        if(!write_fully(descriptor, tile[r].data(), tile.get_columns() * sizeof(data_type), offset + r * tile_size * sizeof(data_type))){
+            std::cerr << "\nWriting the tile to the file failed... \n";
+            throw Matrix();
+        }
+    }
+}
+
+// ========================================================================================================================================== conversions
+Tiled_Matrix Tiled_Matrix::from_matrix(const std::string &path, const Base_Matrix &matrix, size_t tile_size){ // writes an in memory matrix as tiles
+    Tiled_Matrix tiled(path, matrix.get_columns(), matrix.get_rows(), tile_size);
+    for(size_t tr{} ; tr < tiled.get_tile_rows() ; tr++){
+        for(size_t tc{} ; tc < tiled.get_tile_columns() ; tc++){
+            size_t tile_columns = std::min(tile_size, tiled.columns - tc * tile_size);
+            size_t tile_rows = std::min(tile_size, tiled.rows - tr * tile_size);
+            size_t offset = tiled.tile_offset(tr, tc);
+            for(size_t r{} ; r < tile_rows ; r++){ // rows are written directly from the source, no temporary tile
+                const data_type* source = matrix[tr * tile_size + r].data() + tc * tile_size;
+                if(!write_fully(tiled.descriptor, source, tile_columns * sizeof(data_type), offset + r * tile_size * sizeof(data_type))){
+                    std::cerr << "\nWriting the tile to the file failed... \n";
+                    throw Matrix();
+                }
+            }
+        }
+    }
+    return tiled;
+}
+
+Matrix Tiled_Matrix::to_matrix() const{ // loads the whole matrix, it has to fit in the memory
+    Matrix matrix(columns, rows);
+    for(size_t tr{} ; tr < get_tile_rows() ; tr++){
+        for(size_t tc{} ; tc < get_tile_columns() ; tc++){
+            size_t tile_columns = std::min(tile_size, columns - tc * tile_size);
+            size_t tile_rows = std::min(tile_size, rows - tr * tile_size);
+            size_t offset = tile_offset(tr, tc);
+            for(size_t r{} ; r < tile_rows ; r++){
+                data_type* destination = matrix[tr * tile_size + r].data() + tc * tile_size;
+                if(!read_fully(descriptor, destination, tile_columns * sizeof(data_type), offset + r * tile_size * sizeof(data_type))){
+                    std::cerr << "\nReading the tile from the file failed... \n";
+                    throw Matrix();
+                }
+            }
+        }
+    }
+    return matrix;
+}
+
+// ========================================================================================================================================== mathematical operations
+size_t Tiled_Matrix::tile_size_for_budget(size_t memory_budget){ // largest tile size that lets multiply run within the budget (static function)
+    return static_cast<size_t>(std::sqrt(static_cast<double>(memory_budget) / (min_budget_tiles * sizeof(data_type)))); // result tile, current pair and one prefetched pair
+}
+
+Tiled_Matrix Tiled_Matrix::multiply(const Tiled_Matrix &left, const Tiled_Matrix &right, const std::string &result_path, size_t memory_budget){ // out of core matrix multiplication
+    if(left.columns != right.rows){
+        std::cerr << "\nLeft side's amount of columns is not equal to right side's amount of rows... \n";
+        throw Matrix();
+    }
+    if(left.tile_size != right.tile_size){
+        std::cerr << "\nTiled matrices must have the same tile size to be multiplied... \n";
+        throw Matrix();
+    }
+    size_t tile_size = left.tile_size;
+    size_t tile_bytes = tile_size * tile_size * sizeof(data_type);
+    size_t budget_tiles = memory_budget / tile_bytes;
+    if(budget_tiles < min_budget_tiles){ // result tile, current pair and at least one prefetched pair
+        std::cerr << "\nMemory budget is too small for the tile size, it has to hold at least " << min_budget_tiles << " tiles... \n";
+        throw Matrix();
+    }
+    size_t prefetched_pairs = std::min((budget_tiles - resident_tiles_base) / 2, max_prefetched_pairs); // pairs loaded ahead of the one being multiplied
+
+    Tiled_Matrix result(result_path, right.columns, left.rows, tile_size);
+    size_t tile_rows = result.get_tile_rows();
+    size_t tile_columns = result.get_tile_columns();
+    size_t inner_tiles = left.get_tile_columns();
+    size_t steps = tile_rows * tile_columns * inner_tiles; // every step multiplies one pair of tiles, the inner index changes fastest
+
+    auto load_pair = [&left, &right, tile_columns, inner_tiles](size_t step){
+        size_t k = step % inner_tiles;
+        size_t j = (step / inner_tiles) % tile_columns;
+        size_t i = step / inner_tiles / tile_columns;
+        return std::make_pair(left.load_tile(i, k), right.load_tile(k, j));
+    };
+
+    std::deque<std::future<std::pair<Matrix, Matrix>>> pipeline;
+    size_t next_step{};
+    for( ; next_step < steps && next_step < prefetched_pairs ; next_step++)
+        pipeline.push_back(std::async(std::launch::async, load_pair, next_step));
+
+    Matrix product_tile;
+    for(size_t step{} ; step < steps ; step++){
+        size_t k = step % inner_tiles;
+        size_t j = (step / inner_tiles) % tile_columns;
+        size_t i = step / inner_tiles / tile_columns;
+        if(k == 0) // new result tile, the previous one was released after it was stored
+            product_tile = Base_Matrix(std::min(tile_size, result.columns - j * tile_size), std::min(tile_size, result.rows - i * tile_size), 0);
+
+        std::pair<Matrix, Matrix> pair = pipeline.front().get();
+        pipeline.pop_front();
+        if(next_step < steps) // keep the disk busy while the current pair is multiplied, prefetched_pairs stay in flight
+            pipeline.push_back(std::async(std::launch::async, load_pair, next_step++));
+
+        Base_Matrix::multiply_add(pair.first, pair.second, product_tile);
+        if(k + 1 == inner_tiles){
+            result.store_tile(i, j, product_tile);
+            product_tile = Matrix(); // released before the next result tile is allocated
+        }
+    }
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef _TILED_MATRIX_H_
+#define _TILED_MATRIX_H_
+
+// Tiled_Matrix is a disk backed matrix that may be bigger than the memory, it is stored in a file as square tiles of tile_size x tile_size values
+// only the tiles that are being worked on are loaded into memory as ordinary Matrix objects
+// file layout: 64 byte header (magic "TILEDMAT", version, columns, rows, tile size) followed by the tiles in row major order,
+// every tile is stored padded to the full tile size, tiles on the right and bottom edges are loaded with their real dimensions
+
+#include <string>
+#include "Matrix.h"
+
+class Tiled_Matrix{
+    std::string path;
+    int descriptor;
+    size_t columns;
+    size_t rows;
+    size_t tile_size;
+
+    size_t tile_offset(size_t tile_row, size_t tile_column) const; // byte offset of the tile in the file
+
+public:
+// ========================================================================================================================================== constructors and destructor
+    Tiled_Matrix(const std::string &path, size_t columns, size_t rows, size_t tile_size); // creates a new zero filled file
+    Tiled_Matrix(const std::string &path); // opens an existing file
+    Tiled_Matrix(const Tiled_Matrix &source) = delete;
+    Tiled_Matrix(Tiled_Matrix &&source); // move constructor
+    Tiled_Matrix &operator=(const Tiled_Matrix &source) = delete;
+    ~Tiled_Matrix();
+
+// ========================================================================================================================================== getters and setters
+    size_t get_columns() const { return columns; }
+    size_t get_rows() const { return rows; }
+    size_t get_tile_size() const { return tile_size; }
+    size_t get_tile_columns() const { return (columns + tile_size - 1) / tile_size; } // number of tiles in a row of tiles
+    size_t get_tile_rows() const { return (rows + tile_size - 1) / tile_size; } // number of tiles in a column of tiles
+    const std::string &get_path() const { return path; }
+
+// ========================================================================================================================================== tile access
+    Matrix load_tile(size_t tile_row, size_t tile_column) const; // reads the tile from the file
+    void load_tile(size_t tile_row, size_t tile_column, Base_Matrix &tile) const; // reads the tile into existing storage of the right size
+    void store_tile(size_t tile_row, size_t tile_column, const Base_Matrix &tile); // writes the tile to the file
+
+// ========================================================================================================================================== conversions
+    static Tiled_Matrix from_matrix(const std::string &path, const Base_Matrix &matrix, size_t tile_size); // writes an in memory matrix as tiles
+    Matrix to_matrix() const; // loads the whole matrix, it has to fit in the memory
+
+// ========================================================================================================================================== mathematical operations
+    static size_t tile_size_for_budget(size_t memory_budget); // largest tile size that lets multiply run within the budget (static function)
+    static Tiled_Matrix multiply(const Tiled_Matrix &left, const Tiled_Matrix &right, const std::string &result_path, size_t memory_budget); // out of core matrix multiplication
+};
+
+#endif // _TILED_MATRIX_H_
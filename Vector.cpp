@@ -1,5 +1,4 @@
 #include "Vector.h"
-#include <time.h>
 #include <cmath>
 
 // ========================================================================================================================================== constructors and destructor
@@ -15,17 +14,17 @@ Vector::Vector(const Vector &source) : Base_Matrix(source){ // copy constructor
     validate_vector_size();
 }
 
-Vector::Vector(Vector &&source) : Base_Matrix(source){ // move contructor
-    validate_vector_size();
+Vector::Vector(Vector &&source) noexcept : Base_Matrix(std::move(source)){ // move contructor, source is already a valid vector
 }
 
 Vector::~Vector(){
 }
 
 Vector::Vector(const Base_Matrix &source) : Base_Matrix(source){ // copy constructor, copies from Base_Matrix
+    validate_vector_size();
 }
 
-Vector::Vector(Base_Matrix &&source) : Base_Matrix(source){ // move contructor, moves Base_Matrix object
+Vector::Vector(Base_Matrix &&source) : Base_Matrix(checked_vector(std::move(source))){ // move contructor, moves Base_Matrix object, a rejected source keeps its rows
 }
 
 // ========================================================================================================================================== values insertion methods
@@ -50,65 +49,99 @@ void Vector::delete_column(size_t pos){ // delete column
 }
 
 // ========================================================================================================================================== operators
+Vector& Vector::operator=(const Vector &source){ // copy assignment
+    Base_Matrix::operator=(source);
+    return *this;
+}
+
+Vector& Vector::operator=(Vector &&source) noexcept{ // move assignment, source is already a valid vector
+    move_from(std::move(source));
+    return *this;
+}
+
 Vector& Vector::operator=(const Base_Matrix &source){ // copy assignment, copies from Base_Matrix
     if(this == &source)
         return *this;
-    rows = source.get_rows();
-    columns = source.get_columns();
-    
-    validate_vector_size(); // check whether the copied Matrice is a vector, before messing with the pointers and data
-    
-    delete[] rows_of_values;
-    rows_of_values = new Base_Vector[rows];
-    for(size_t r{} ; r < rows ; r++)
-        rows_of_values[r] = source[r];
+    validate_vector_size(source); // check whether the copied Matrice is a vector, before messing with the pointers and data
+    Base_Matrix::operator=(source);
     return *this;
 }
 
 Vector& Vector::operator=(Base_Matrix &&source){ // move assignment,  moves Base_Matrix object
     if(this == &source)
         return *this;
-    rows = source.get_rows();
-    columns = source.get_columns();
-    
-    validate_vector_size(); // check whether the moved Matrice is a vector, before messing with the pointers and data
-    
-    delete[] rows_of_values;
-    rows_of_values = source.get_ptr();
-    source.set_ptr(nullptr);
+    validate_vector_size(source); // check whether the moved Matrice is a vector, before messing with the pointers and data
+    move_from(std::move(source));
     return *this;
 }
 
+// ========================================================================================================================================== binary input and output
+Vector Vector::load(const std::string &path){ // reads the vector from the binary file
+    Vector loaded;
+    loaded.read_binary(path, false);
+    loaded.validate_vector_size();
+    return loaded;
+}
+
+Vector Vector::map(const std::string &path){ // memory maps the binary file
+    Vector mapped;
+    mapped.read_binary(path, true);
+    mapped.validate_vector_size();
+    return mapped;
+}
+
 //========================================================================================================================================== random generation
 Vector Vector::generate_random(size_t length, data_type upper_limit, data_type lower_limit, data_type precission){ // random Vector of given length generator
+    return Vector::generate_random(length, Random_Generator(), upper_limit, lower_limit, precission); // fresh seed on every call
+}
+
+Vector Vector::generate_random(size_t length, const Random_Generator &generator, data_type upper_limit, data_type lower_limit, data_type precission){ // reproducible version, uses the given generator
     if(precission == 0){
         std::cerr << "\nPrecission cannot be equal to 0... \n";
         throw Vector();
     }
+    if(upper_limit < lower_limit){
+        std::cerr << "\nUpper limit cannot be smaller than lower limit... \n";
+        throw Vector();
+    }
     
-    upper_limit /= precission; // dividing by precision to achieve random fractions
-    lower_limit /= precission;
-    int random_remainder{static_cast<int>(std::ceil((upper_limit - lower_limit + 1)))}; // random numbers are the remainders of dividing rand() by this number
+    data_type lower_step{std::ceil(lower_limit / precission - 1e-9)}; // dividing by precision to achieve random fractions
+    data_type upper_step{std::floor(upper_limit / precission + 1e-9)};
     
-    if(random_remainder > static_cast<int>(RAND_MAX)){
-        std::cerr << "\nRandom vector generator range is too big, ((upper_limit - lower_limit) / precission) value is too big... \n";
+    if(upper_step < lower_step || std::fabs(lower_step) > 9e18 || std::fabs(upper_step) > 9e18){
+        std::cerr << "\nRandom vector generator range is invalid, ((upper_limit - lower_limit) / precission) value is too big or too small... \n";
         throw Vector();
     }
     
     Vector random(length);
-    srand(time(nullptr));
-    
-    for(size_t r{} ; r < random.rows ; r++)
-        for(size_t c{} ; c < random.columns ; c++){
-            random[r][c] = rand() % random_remainder - upper_limit; // upper_limit is subtracted to achieve negative numbers
-            random[r][c] *= precission; // back to given precission
-        }
+    generator.fill_integer(random, static_cast<int64_t>(lower_step), static_cast<int64_t>(upper_step), precission); // back to given precission
+    return random;
+}
+
+Vector Vector::generate_uniform(size_t length, const Random_Generator &generator, data_type lower_limit, data_type upper_limit){ // uniform values from [lower_limit, upper_limit)
+    Vector random(length);
+    generator.fill_uniform(random, lower_limit, upper_limit);
+    return random;
+}
+
+Vector Vector::generate_normal(size_t length, const Random_Generator &generator, data_type mean, data_type standard_deviation){ // normally distributed values
+    Vector random(length);
+    generator.fill_normal(random, mean, standard_deviation);
     return random;
 }
 
 // ========================================================================================================================================== validation methods
 void Vector::validate_vector_size() const{ // this method checks whether at least one dimension is equal to 1
-    if(rows != 1 && columns != 1){
+    validate_vector_size(*this);
+}
+
+Base_Matrix &&Vector::checked_vector(Base_Matrix &&matrix){ // validates the shape before the matrix is moved from
+    validate_vector_size(matrix);
+    return std::move(matrix);
+}
+
+void Vector::validate_vector_size(const Base_Matrix &matrix){ // checks the dimensions of any Base_Matrix
+    if(matrix.get_rows() != 1 && matrix.get_columns() != 1){
         std::cerr << "\nVector must have either 1 row or 1 column...\n";
         throw Vector();
     }
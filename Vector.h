@@ -2,6 +2,7 @@
 #define _VECTOR_H_
 
 #include "Base_Matrix.h"
+#include "Random_Generator.h"
 
 // Vector is a sub class of Base_Matrix that has almost no additional functionalities
 // Vector is basically a matrice that has one dimension equal to 1, and it is being checked so that the Vector has one dimension equal to 1
@@ -16,7 +17,7 @@ public:
     Vector(size_t columns = 1, size_t rows = 1, data_type init_value = 0); // default constructor
     Vector(const std::initializer_list<Base_Vector> &init_list); // initializer list constructor
     Vector(const Vector &source); // copy constructor
-    Vector(Vector &&source); // move contructor,  moves Base_Matrix object
+    Vector(Vector &&source) noexcept; // move contructor,  moves Base_Matrix object
     virtual ~Vector();
     
     Vector(const Base_Matrix &source); // copy constructor, copies from Base_Matrix
@@ -30,15 +31,26 @@ public:
     virtual void delete_column(size_t pos); // delete column
 
 // ========================================================================================================================================== operators
+    Vector& operator=(const Vector &source); // copy assignment
+    Vector& operator=(Vector &&source) noexcept; // move assignment
     virtual Vector& operator=(const Base_Matrix &source); // copy assignment, copies from Base_Matrix
     virtual Vector& operator=(Base_Matrix &&source); // move assignment,  moves Base_Matrix object
     
+// ========================================================================================================================================== binary input and output
+    static Vector load(const std::string &path); // reads the vector from the binary file
+    static Vector map(const std::string &path); // memory maps the binary file, values are backed directly by the file
+    
 //========================================================================================================================================== random generation
     static Vector generate_random(size_t length, data_type upper_limit = 10, data_type lower_limit = -10, data_type precission = 0.1); // random Vector of given length generator
+    static Vector generate_random(size_t length, const Random_Generator &generator, data_type upper_limit = 10, data_type lower_limit = -10, data_type precission = 0.1); // reproducible version, uses the given generator
+    static Vector generate_uniform(size_t length, const Random_Generator &generator, data_type lower_limit = 0, data_type upper_limit = 1); // uniform values from [lower_limit, upper_limit)
+    static Vector generate_normal(size_t length, const Random_Generator &generator, data_type mean = 0, data_type standard_deviation = 1); // normally distributed values
 
 private:
 // ========================================================================================================================================== validation methods
     void validate_vector_size() const; // this method checks whether at least one dimension is equal to 1
+    static void validate_vector_size(const Base_Matrix &matrix); // checks the dimensions of any Base_Matrix
+    static Base_Matrix &&checked_vector(Base_Matrix &&matrix); // validates the shape before the matrix is moved from
 };
 
 #endif // _VECTOR_H_
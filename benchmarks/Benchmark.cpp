@@ -0,0 +1,233 @@
+// Benchmark is a small self contained harness that measures every public operation of the library over a sweep of sizes
+// every case is repeated until it ran for at least the minimal time, the median time of a single run is reported
+// results are printed one per line as JSON (default) or CSV, so they can be compared between versions by a script
+//
+// build (from the repository root): g++ -std=c++17 -O2 -pthread -I. *.cpp benchmarks/Benchmark.cpp -o benchmark
+// usage: benchmark [--sizes 64,128,256] [--filter substring] [--min-time seconds] [--format json|csv] [--threads count]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Matrix.h"
+#include "Vector.h"
+#include "Parallel.h"
+#include "Krylov_Solver.h"
+#include "Factorization.h"
+#include "Executor.h"
+#include "Numa.h"
+
+static volatile data_type sink; // results are stored here so the compiler cannot remove the measured work
+static const uint64_t benchmark_seed{20220907};
+
+struct Settings{
+    std::vector<size_t> sizes{64, 128, 256, 512};
+    std::string filter;
+    double min_time{0.2};
+    bool csv{false};
+};
+
+struct Case{
+    std::string name;
+    size_t n;
+    double flops; // floating point operations of a single run
+    double bytes; // bytes read and written by a single run
+    std::function<void()> setup; // called before every run, not measured
+    std::function<void()> run;
+};
+
+// ========================================================================================================================================== measurement
+static void measure(const Settings &settings, const Case &c){
+    if(!settings.filter.empty() && c.name.find(settings.filter) == std::string::npos)
+        return;
+    using clock = std::chrono::steady_clock;
+    std::vector<double> times;
+    double total{};
+    for(size_t i{} ; i < 3 || (total < settings.min_time && i < 100000) ; i++){
+        if(c.setup)
+            c.setup();
+        auto start = clock::now();
+        c.run();
+        double seconds = std::chrono::duration<double>(clock::now() - start).count();
+        if(i > 0) // the first run warms up the caches and the allocator
+            times.push_back(seconds);
+        total += seconds;
+    }
+    std::sort(times.begin(), times.end());
+    double median = times[times.size() / 2];
+    double gflops = (c.flops > 0) ? c.flops / median * 1e-9 : 0;
+    double gbytes = (c.bytes > 0) ? c.bytes / median * 1e-9 : 0;
+
+    if(settings.csv)
+        std::printf("%s,%zu,%zu,%.1f,%.4f,%.4f\n", c.name.c_str(), c.n, times.size(), median * 1e9, gflops, gbytes);
+    else
+        std::printf("{\"benchmark\":\"%s\",\"n\":%zu,\"iterations\":%zu,\"ns_per_op\":%.1f,\"gflops\":%.4f,\"gbytes_per_s\":%.4f}\n",
+            c.name.c_str(), c.n, times.size(), median * 1e9, gflops, gbytes);
+    std::fflush(stdout);
+}
+
+// ========================================================================================================================================== cases
+static void run_cases(const Settings &settings, size_t n){
+    const double element = sizeof(data_type);
+    const double n2 = static_cast<double>(n) * n;
+    const double n3 = n2 * n;
+    Random_Generator generator(benchmark_seed);
+    Matrix a = Matrix::generate_normal(n, n, generator);
+    Matrix b = Matrix::generate_normal(n, n, Random_Generator(benchmark_seed + 1));
+    Matrix diagonal_dominant = a + Matrix::identity_matrix(n) * static_cast<data_type>(n); // well conditioned, no zero pivots
+    Matrix scratch;
+    Matrix moved(n, n);
+
+    // construction, copy and move
+    measure(settings, {"construct", n, 0, n2 * element, nullptr, [&](){ Matrix m(n, n, 1); sink = m[0][0]; }});
+    measure(settings, {"copy", n, 0, 2 * n2 * element, nullptr, [&](){ Matrix m(a); sink = m[0][0]; }});
+    measure(settings, {"move", n, 0, 0, nullptr, [&](){ Matrix m(std::move(moved)); moved = std::move(m); }});
+    Base_Matrix::set_copy_on_write(true);
+    measure(settings, {"copy_on_write", n, 0, 0, nullptr, [&](){ Matrix m(a); sink = static_cast<const Matrix&>(m)[0][0]; }}); // compare with copy
+    measure(settings, {"copy_on_write_detach", n, 0, 2 * n2 * element, nullptr, [&](){ Matrix m(a); m[0][0] = 1; sink = m[0][0]; }});
+    Base_Matrix::set_copy_on_write(false);
+    Numa::set_allocation_policy(Numa::Interleaved); // from n = 512 the matrix reaches the 2 MB threshold, on a single node machine nothing changes
+    measure(settings, {"construct_interleaved", n, 0, n2 * element, nullptr, [&](){ Matrix m(n, n, 1); sink = m[0][0]; }}); // compare with construct
+    Matrix interleaved = a;
+    measure(settings, {"sum_interleaved", n, n2, n2 * element, nullptr, [&](){ sink = interleaved.sum(); }}); // compare with sum
+    Numa::set_allocation_policy(Numa::First_Touch);
+
+    // element wise operations
+    measure(settings, {"add", n, n2, 3 * n2 * element, nullptr, [&](){ scratch = a + b; sink = scratch[0][0]; }});
+    measure(settings, {"add_assign", n, n2, 3 * n2 * element, nullptr, [&](){ a += b; a -= b; }});
+    measure(settings, {"scalar_multiply", n, n2, 2 * n2 * element, nullptr, [&](){ scratch = a * 1.5; sink = scratch[0][0]; }});
+    measure(settings, {"element_wise_product", n, n2, 3 * n2 * element, nullptr, [&](){ scratch = Base_Matrix::element_wise_product(a, b); sink = scratch[0][0]; }});
+    measure(settings, {"negate", n, n2, 2 * n2 * element, nullptr, [&](){ scratch = -a; sink = scratch[0][0]; }});
+    Base_Matrix column_means = a.column_means();
+    Base_Matrix column_scales = a.column_norms();
+    measure(settings, {"standardize_columns", n, 2 * n2, 4 * n2 * element, [&](){ scratch = a; }, [&](){ scratch -= column_means; scratch /= column_scales; }});
+
+    // matrix multiplication of different shapes
+    measure(settings, {"multiply_square", n, 2 * n3, 3 * n2 * element, nullptr, [&](){ scratch = a * b; sink = scratch[0][0]; }});
+    Matrix tall = Matrix::generate_normal(32, 8 * n, generator); // 8n x 32
+    Matrix skinny = Matrix::generate_normal(32, 32, generator);
+    measure(settings, {"multiply_tall_skinny", n, 2.0 * 8 * n * 32 * 32, (2.0 * 8 * n * 32 + 32 * 32) * element, nullptr, [&](){ scratch = tall * skinny; sink = scratch[0][0]; }});
+    Matrix column = Matrix::generate_normal(1, n, generator); // n x 1
+    measure(settings, {"multiply_gemv", n, 2 * n2, (n2 + 2 * n) * element, nullptr, [&](){ scratch = a * column; sink = scratch[0][0]; }});
+    size_t default_cutoff = Base_Matrix::get_strassen_cutoff();
+    for(size_t cutoff : {64, 128, 256, 512}){ // compared with multiply_square this shows the size where Strassen starts to pay off, gflops are those of the standard product
+        Base_Matrix::set_strassen_cutoff(cutoff);
+        measure(settings, {"multiply_strassen_cutoff_" + std::to_string(cutoff), n, 2 * n3, 3 * n2 * element, nullptr, [&](){
+            scratch = Base_Matrix::multiply(a, b, Base_Matrix::Strassen_Winograd); sink = scratch[0][0]; }});
+    }
+    Base_Matrix::set_strassen_cutoff(default_cutoff);
+    Matrix stochastic = a * (0.5 / n); // small enough for the powers to stay finite
+    measure(settings, {"power_16", n, 4 * 2 * n3, 0, nullptr, [&](){ scratch = stochastic.power(16); sink = scratch[0][0]; }});
+    measure(settings, {"exp", n, 0, 0, nullptr, [&](){ scratch = stochastic.exp(); sink = scratch[0][0]; }});
+    std::vector<Base_Matrix> products(4);
+    measure(settings, {"multiply_square_x4_async", n, 4 * 2 * n3, 4 * 3 * n2 * element, nullptr, [&](){ // four independent products on the executor, compare with 4 x multiply_square
+        std::vector<std::future<Base_Matrix>> futures;
+        for(size_t p{} ; p < products.size() ; p++)
+            futures.push_back(Executor::shared().submit([&a, &b](){ return a * b; }));
+        for(size_t p{} ; p < products.size() ; p++)
+            products[p] = futures[p].get();
+        sink = products[0][0][0]; }});
+
+    // structural operations
+    measure(settings, {"transpone", n, 0, 2 * n2 * element, nullptr, [&](){ scratch = a.transpone(); sink = scratch[0][0]; }});
+    Base_Vector row(n, 1);
+    Base_Vector inserted_column(n, 1);
+    measure(settings, {"insert_row", n, 0, 0, [&](){ scratch = a; }, [&](){ scratch.insert_row(row, n / 2); }});
+    measure(settings, {"insert_column", n, 0, 2 * n2 * element, [&](){ scratch = a; }, [&](){ scratch.insert_column(inserted_column, n / 2); }});
+
+    // reductions
+    measure(settings, {"sum", n, n2, n2 * element, nullptr, [&](){ sink = a.sum(); }});
+    measure(settings, {"argmax", n, n2, n2 * element, nullptr, [&](){ sink = a.argmax().second; }});
+    measure(settings, {"frobenius_norm", n, 2 * n2, n2 * element, nullptr, [&](){ sink = a.frobenius_norm(); }});
+    measure(settings, {"norm_1", n, n2, n2 * element, nullptr, [&](){ sink = a.norm_1(); }});
+    measure(settings, {"column_sums", n, n2, n2 * element, nullptr, [&](){ scratch = a.column_sums(); sink = scratch[0][0]; }});
+    measure(settings, {"dot", n, 2 * n2, 2 * n2 * element, nullptr, [&](){ sink = Base_Matrix::dot(a, b); }});
+
+    // decompositions
+    measure(settings, {"LU_decomposition", n, 2 * n3 / 3, 0, nullptr, [&](){ auto LU = Matrix::LU_decomposition(diagonal_dominant); sink = LU.second[0][0]; }});
+    measure(settings, {"determinant", n, 2 * n3 / 3, 0, nullptr, [&](){ sink = diagonal_dominant.determinant(); }});
+    measure(settings, {"invert", n, 2 * n3 / 3 + 2 * n3, 0, nullptr, [&](){ scratch = diagonal_dominant.invert(); sink = scratch[0][0]; }});
+
+    // iterative solvers, a fixed number of iterations on the 2D Poisson matrix with n * n unknowns
+    std::vector<Sparse_Matrix::Entry> entries;
+    for(size_t i{} ; i < n ; i++)
+        for(size_t j{} ; j < n ; j++){
+            size_t row = i * n + j;
+            entries.push_back({row, row, 4});
+            if(i > 0) entries.push_back({row, row - n, -1});
+            if(i + 1 < n) entries.push_back({row, row + n, -1});
+            if(j > 0) entries.push_back({row, row - 1, -1});
+            if(j + 1 < n) entries.push_back({row, row + 1, -1});
+        }
+    Sparse_Matrix poisson = Sparse_Matrix::from_entries(n * n, n * n, entries);
+    Vector rhs = Vector::generate_normal(n * n, generator);
+    Vector solution;
+    ILU_Preconditioner ilu(poisson);
+    Krylov_Solver solver(0, 20, 20); // zero tolerance, always 20 iterations
+    double iteration_flops = 2.0 * poisson.get_non_zeros() + 10.0 * n2;
+    measure(settings, {"conjugate_gradient_20", n, 20 * iteration_flops, 0, nullptr, [&](){ solution = Vector(); sink = solver.conjugate_gradient(poisson, rhs, solution).relative_residual; }});
+    measure(settings, {"gmres_ilu_20", n, 0, 0, nullptr, [&](){ solution = Vector(); sink = solver.gmres(poisson, rhs, solution, &ilu).relative_residual; }});
+
+    // low rank updates of factorizations and inverses, to be compared with LU_decomposition and invert
+    Cholesky_Factorization cholesky(diagonal_dominant * diagonal_dominant.transpone());
+    Matrix inverse = diagonal_dominant.invert();
+    Vector update_vector = Vector::generate_normal(n, generator) * 1e-3;
+    measure(settings, {"cholesky_update_downdate", n, 8 * n2, 0, nullptr, [&](){ cholesky.update(update_vector); cholesky.downdate(update_vector); }});
+    measure(settings, {"sherman_morrison", n, 6 * n2, 0, nullptr, [&](){ Inverse_Update::sherman_morrison(inverse, update_vector, update_vector); }});
+
+    // random generation
+    measure(settings, {"generate_random", n, 0, n2 * element, nullptr, [&](){ scratch = Matrix::generate_random(n, n, generator); sink = scratch[0][0]; }});
+    measure(settings, {"generate_normal", n, 0, n2 * element, nullptr, [&](){ scratch = Matrix::generate_normal(n, n, generator); sink = scratch[0][0]; }});
+}
+
+// ========================================================================================================================================== main
+static std::vector<size_t> parse_sizes(const char* text){
+    std::vector<size_t> sizes;
+    for(const char* p = text ; *p != '\0' ; ){
+        char* end{nullptr};
+        size_t size = std::strtoul(p, &end, 10);
+        if(end == p || size == 0){
+            std::fprintf(stderr, "Invalid list of sizes: %s\n", text);
+            std::exit(1);
+        }
+        sizes.push_back(size);
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return sizes;
+}
+
+int main(int argc, char** argv){
+    Settings settings;
+    for(int i{1} ; i < argc ; i++){
+        std::string argument = argv[i];
+        bool has_value = i + 1 < argc;
+        if(argument == "--sizes" && has_value)
+            settings.sizes = parse_sizes(argv[++i]);
+        else if(argument == "--filter" && has_value)
+            settings.filter = argv[++i];
+        else if(argument == "--min-time" && has_value)
+            settings.min_time = std::atof(argv[++i]);
+        else if(argument == "--format" && has_value)
+            settings.csv = std::string(argv[++i]) == "csv";
+        else if(argument == "--threads" && has_value)
+            Parallel::set_thread_count(std::strtoul(argv[++i], nullptr, 10));
+        else{
+            std::fprintf(stderr, "usage: %s [--sizes 64,128,256] [--filter substring] [--min-time seconds] [--format json|csv] [--threads count]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(settings.csv)
+        std::printf("benchmark,n,iterations,ns_per_op,gflops,gbytes_per_s\n");
+    else
+        std::printf("{\"context\":{\"threads\":%zu,\"seed\":%llu}}\n", Parallel::get_thread_count(), static_cast<unsigned long long>(benchmark_seed));
+    for(size_t n : settings.sizes)
+        run_cases(settings, n);
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Allocations checks that the operations working on existing storage do not allocate or copy, so a regression shows up as a failure
+// every heap allocation is counted by the replacement global operator new below, the copies by the Vector_Copy and Matrix_Copy records,
+// so the library has to be compiled with MATRICES_INSTRUMENTATION
+// the loops run on the calling thread: the threads of a parallel loop are the cost of the fork-join model (see Parallel.h), not of the operation
+// the exit code is the number of failed checks
+//
+// build (from the repository root): g++ -std=c++17 -O2 -pthread -DMATRICES_INSTRUMENTATION -I. *.cpp tests/Allocations.cpp -o allocations
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Instrumentation.h"
+#include "Krylov_Solver.h"
+#include "Matrix.h"
+#include "Parallel.h"
+#include "Vector.h"
+
+#ifndef MATRICES_INSTRUMENTATION
+#error "tests/Allocations.cpp needs the library compiled with -DMATRICES_INSTRUMENTATION"
+#endif
+
+static const size_t test_size{64};
+static std::atomic<uint64_t> heap_allocations{0};
+
+// ========================================================================================================================================== counting allocator
+void* operator new(std::size_t size){ // the array and nothrow forms of the standard library forward to this one
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* address = std::malloc(size == 0 ? 1 : size))
+        return address;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment){ // over aligned types
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if(void* address = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return address;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* address) noexcept { std::free(address); }
+void operator delete(void* address, std::size_t) noexcept { std::free(address); }
+void operator delete(void* address, std::align_val_t) noexcept { std::free(address); }
+void operator delete(void* address, std::size_t, std::align_val_t) noexcept { std::free(address); }
+
+struct Allocations{
+    uint64_t allocated; // heap allocations
+    uint64_t copied; // Vector_Copy and Matrix_Copy calls
+
+    bool operator==(const Allocations &other) const { return allocated == other.allocated && copied == other.copied; }
+};
+
+static Allocations count(const std::function<void()> &operation){ // allocations and copies made by the operation
+    Instrumentation::reset();
+    uint64_t before = heap_allocations.load(std::memory_order_relaxed);
+    operation();
+    uint64_t allocated = heap_allocations.load(std::memory_order_relaxed) - before;
+    auto counters = Instrumentation::snapshot();
+    return {allocated, counters[Instrumentation::Vector_Copy].calls + counters[Instrumentation::Matrix_Copy].calls};
+}
+
+static size_t failures{};
+
+static void expect(const std::string &name, const Allocations &actual, const Allocations &expected){
+    bool passed = actual == expected;
+    std::printf("%s %s: %llu allocations, %llu copies (expected %llu, %llu)\n", passed ? "ok  " : "FAIL", name.c_str(),
+        static_cast<unsigned long long>(actual.allocated), static_cast<unsigned long long>(actual.copied),
+        static_cast<unsigned long long>(expected.allocated), static_cast<unsigned long long>(expected.copied));
+    if(!passed)
+        failures++;
+}
+
+static void expect_none(const std::string &name, const std::function<void()> &operation){ // the operation must neither allocate nor copy
+    expect(name, count(operation), {0, 0});
+}
+
+static void expect_no_allocation(const std::string &name, const std::function<void()> &operation){ // copies into existing storage are allowed
+    Allocations actual = count(operation);
+    expect(name, actual, {0, actual.copied});
+}
+
+static Matrix filled(size_t columns, size_t rows, data_type offset){ // small values, so every operation stays finite
+    Matrix matrix(columns, rows);
+    for(size_t r{} ; r < rows ; r++)
+        for(size_t c{} ; c < columns ; c++)
+            matrix[r][c] = offset + static_cast<data_type>((r * columns + c) % 7) / 8;
+    return matrix;
+}
+
+// ========================================================================================================================================== checks
+static void check_multiplication(){
+    Matrix left = filled(test_size, test_size, 1), right = filled(test_size, test_size, 2), result(test_size, test_size);
+    expect_none("multiply into existing storage", [&](){ Base_Matrix::multiply(left, right, result, Base_Matrix::Standard); });
+    size_t cutoff = Base_Matrix::get_strassen_cutoff();
+    Base_Matrix::set_strassen_cutoff(16); // a few levels of recursion even for the small test size
+    Base_Matrix::multiply(left, right, result, Base_Matrix::Strassen_Winograd); // the first product of a size grows the workspace arena of the thread
+    expect_none("multiply into existing storage (Strassen)", [&](){ Base_Matrix::multiply(left, right, result, Base_Matrix::Strassen_Winograd); });
+    Base_Matrix::set_strassen_cutoff(cutoff);
+    expect_none("multiply_add", [&](){ Base_Matrix::multiply_add(left, right, result); });
+}
+
+static void check_in_place_operators(){
+    Matrix matrix = filled(test_size, test_size, 1), other = filled(test_size, test_size, 2);
+    Matrix row = filled(test_size, 1, 1), column = filled(1, test_size, 1);
+    expect_none("+= double", [&](){ matrix += 1; });
+    expect_none("-= double", [&](){ matrix -= 1; });
+    expect_none("*= double", [&](){ matrix *= 2; });
+    expect_none("/= double", [&](){ matrix /= 2; });
+    expect_none("+= matrix", [&](){ matrix += other; });
+    expect_none("-= matrix", [&](){ matrix -= other; });
+    expect_none("/= matrix", [&](){ matrix /= other; });
+    expect_none("element_wise_multiply", [&](){ matrix.element_wise_multiply(other); });
+    expect_none("+= broadcast row", [&](){ matrix += row; });
+    expect_none("-= broadcast column", [&](){ matrix -= column; });
+    expect_none("/= broadcast row", [&](){ matrix /= row; });
+    expect_none("element_wise_multiply broadcast column", [&](){ matrix.element_wise_multiply(column); });
+}
+
+static void check_moves(){
+    Matrix source = filled(test_size, test_size, 1);
+    expect_none("Matrix move construction", [&](){ Matrix moved(std::move(source)); source = std::move(moved); });
+    Vector vector(1, test_size, 1);
+    expect_none("Vector move construction", [&](){ Vector moved(std::move(vector)); vector = std::move(moved); });
+    std::vector<Matrix> matrices(4, filled(8, 8, 1));
+    expect("std::vector<Matrix> relocation", count([&](){ matrices.reserve(64); }), {1, 0}); // the new buffer of the std::vector only
+    Matrix left = filled(test_size, test_size, 1), right = filled(test_size, test_size, 2);
+    expect("Matrix from a product", count([&](){ Matrix product = left * right; }), {test_size + 1, 0}); // the row array and the rows of the product only
+}
+
+static void check_power(){ // power allocates its buffers once, the count must not grow with the exponent
+    Matrix matrix = filled(test_size, test_size, 0);
+    matrix /= static_cast<data_type>(test_size); // spectral radius below 1, high powers stay finite
+    Allocations once = count([&](){ Matrix result = matrix.power(2); });
+    expect("power 1000 against power 2", count([&](){ Matrix result = matrix.power(1000); }), once);
+    expect("power 1023 against power 2", count([&](){ Matrix result = matrix.power(1023); }), once);
+}
+
+static void check_solvers(){ // a warmed up solver does not allocate, whatever the number of iterations
+    const size_t n{20000}; // long enough for the reductions to be split into blocks
+    std::vector<Sparse_Matrix::Entry> entries;
+    for(size_t i{} ; i < n ; i++){
+        entries.push_back({i, i, 4});
+        if(i + 1 < n){
+            entries.push_back({i, i + 1, -1});
+            entries.push_back({i + 1, i, -1});
+        }
+    }
+    Sparse_Matrix sparse = Sparse_Matrix::from_entries(n, n, entries);
+    Linear_Operator A(sparse);
+    Jacobi_Preconditioner jacobi(sparse);
+    Vector b(1, n, 1), x(1, n, 0);
+    Krylov_Solver solver(0, 50, 10); // tolerance 0, every solve runs all its iterations
+    auto solve = [&](const std::string &name, const std::function<void()> &run){
+        run(); // the first solve of the size prepares the workspace
+        solver.set_max_iterations(5);
+        expect_no_allocation(name + " 5 iterations", run);
+        solver.set_max_iterations(50);
+        expect_no_allocation(name + " 50 iterations", run);
+    };
+    solve("conjugate_gradient", [&](){ solver.conjugate_gradient(A, b, x); });
+    solve("conjugate_gradient with Jacobi", [&](){ solver.conjugate_gradient(A, b, x, &jacobi); });
+    solve("bicgstab", [&](){ solver.bicgstab(A, b, x); });
+    solve("gmres", [&](){ solver.gmres(A, b, x); });
+}
+
+// ========================================================================================================================================== main
+int main(){
+    Parallel::set_thread_count(1);
+    check_multiplication();
+    check_in_place_operators();
+    check_moves();
+    check_power();
+    check_solvers();
+    std::printf("%zu failed\n", failures);
+    return static_cast<int>(failures);
+}
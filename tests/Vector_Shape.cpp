@@ -0,0 +1,71 @@
+// Vector_Shape checks that a Vector never ends up with two dimensions larger than 1, whichever path the assignment takes
+// a rejected assignment or construction has to throw and leave both the vector and the source untouched
+// the exit code is the number of failed checks
+//
+// build (from the repository root): g++ -std=c++17 -O2 -pthread -I. *.cpp tests/Vector_Shape.cpp -o vector_shape
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include "Matrix.h"
+#include "Vector.h"
+
+static size_t failures{};
+
+static void expect(const std::string &name, bool passed){
+    std::printf("%s %s\n", passed ? "ok  " : "FAIL", name.c_str());
+    if(!passed)
+        failures++;
+}
+
+static bool throws(const std::function<void()> &operation){
+    try{
+        operation();
+    }
+    catch(...){
+        return true;
+    }
+    return false;
+}
+
+static bool is_vector(const Base_Matrix &matrix){
+    return matrix.get_columns() == 1 || matrix.get_rows() == 1;
+}
+
+// ========================================================================================================================================== checks
+static void check_assignments(){
+    Vector vector(1, 3, 1.0);
+    expect("*= a matrix giving a non vector shape throws", throws([&](){ vector *= Matrix(3, 1, 1.0); }));
+    expect("the vector keeps its shape after *=", vector.get_columns() == 1 && vector.get_rows() == 3);
+
+    Base_Matrix &base = vector;
+    expect("move assignment through the base throws", throws([&](){ base = Matrix(3, 3); }));
+    Matrix square(3, 3);
+    expect("copy assignment through the base throws", throws([&](){ base = square; }));
+    expect("the vector keeps its shape after the assignments", is_vector(vector) && vector.get_rows() == 3);
+
+    Vector other(1, 3, 2.0);
+    base = std::move(other);
+    expect("a vector can still be moved through the base", vector.get_rows() == 3 && vector[2][0] == 2.0);
+    vector *= Matrix(1, 1, 3.0);
+    expect("*= a matrix keeping the vector shape works", vector.get_rows() == 3 && vector[0][0] == 6.0);
+}
+
+static void check_constructions(){
+    Matrix square(3, 3, 5.0);
+    expect("moving a non vector into a Vector throws", throws([&](){ Vector vector(std::move(square)); }));
+    expect("the rejected source keeps its values", square.get_columns() == 3 && square.get_rows() == 3 && square[2][2] == 5.0);
+
+    Vector vector(1, 3, 1.0);
+    expect("move assignment of a non vector throws", throws([&](){ vector = std::move(square); }));
+    expect("the rejected source keeps its values after the assignment", square.get_rows() == 3 && square[1][1] == 5.0);
+}
+
+// ========================================================================================================================================== main
+int main(){
+    check_assignments();
+    check_constructions();
+    std::printf("%zu failed\n", failures);
+    return static_cast<int>(failures);
+}